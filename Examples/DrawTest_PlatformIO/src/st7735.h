@@ -18,15 +18,34 @@
 
 #include <stdint.h>
 
+// Note: For a vertical screen, uncomment the following line.
+// The text console scrolls in hardware on a vertical screen only, the panel
+// scrolls along its long side.
+//  #define ST7735_VERTICAL
+
 // Define screen resolution and offset
-#define ST7735_WIDTH    160
-#define ST7735_HEIGHT   80
-#define ST7735_X_OFFSET 1
-#define ST7735_Y_OFFSET 26
+#ifndef ST7735_VERTICAL
+    #define ST7735_WIDTH    160
+    #define ST7735_HEIGHT   80
+    #define ST7735_X_OFFSET 1
+    #define ST7735_Y_OFFSET 26
+#else
+    #define ST7735_WIDTH    80
+    #define ST7735_HEIGHT   160
+    #define ST7735_X_OFFSET 26
+    #define ST7735_Y_OFFSET 1
+#endif
 
 // Note: To not use CS, uncomment the following line and pull CS to ground.
 //  #define ST7735_NO_CS
 
+// Note: To send pixel data in the background, uncomment the following line.
+// DMA transfers are queued and completed by the DMA1 channel 3 interrupt, the
+// drawing functions return before the data is sent. Bitmaps passed to
+// tft_draw_bitmap() and tiles passed to tft_fill_pattern() must stay valid
+// until tft_wait() returns.
+//  #define ST7735_DMA_ASYNC
+
 #define RGB565(r, g, b) ((((r)&0xF8) << 8) | (((g)&0xFC) << 3) | ((b) >> 3))
 #define BGR565(r, g, b) ((((b)&0xF8) << 8) | (((g)&0xFC) << 3) | ((r) >> 3))
 #define RGB             RGB565
@@ -51,13 +70,78 @@
 #define GREENYELLOW RGB(173, 255, 41)
 #define PINK        RGB(255, 130, 198)
 
+/// \brief Point
+typedef struct
+{
+    int16_t x;  // X coordinate, from left to right.
+    int16_t y;  // Y coordinate, from top to bottom.
+} point_t;
+
+/// \brief Ring Gauge
+/// \details Angles are in degrees, clockwise from 12 o'clock. The angle of
+/// a value is rounded down, exact for full scales up to 2896.
+typedef struct
+{
+    int16_t  x;          // Center X coordinate
+    int16_t  y;          // Center Y coordinate
+    uint16_t r;          // Outer radius
+    uint16_t ir;         // Inner radius
+    int16_t  start;      // Angle of value 0
+    int16_t  sweep;      // Angle from value 0 to max_value, 0 - 360.
+    uint16_t max_value;  // Full scale value
+    uint16_t color;      // Value color
+    uint16_t bg_color;   // Track color
+    uint32_t scale;      // Degrees per value, 9.23 fixed point, set by tft_draw_ring().
+} ring_t;
+
+// Text alignment in a box, one horizontal or-ed with one vertical
+#define TEXT_ALIGN_LEFT   0x00
+#define TEXT_ALIGN_CENTER 0x01
+#define TEXT_ALIGN_RIGHT  0x02
+#define TEXT_ALIGN_TOP    0x00
+#define TEXT_ALIGN_MIDDLE 0x04
+#define TEXT_ALIGN_BOTTOM 0x08
+
+/// \brief Glyph of a Proportional Font
+typedef struct
+{
+    uint16_t offset;    // First byte of the glyph in the font bitmap
+    uint8_t  width;     // Bitmap width
+    uint8_t  height;    // Bitmap height
+    uint8_t  advance;   // Distance to the next cursor position
+    int8_t   x_offset;  // From the cursor to the left of the bitmap
+    int8_t   y_offset;  // From the top of the line to the top of the bitmap
+} glyph_t;
+
+/// \brief Proportional Font
+/// \details Glyph bitmaps are packed row-major, MSB first, and each glyph
+/// starts on a byte. Rows are not padded. Anti-aliased fonts store 2 or 4
+/// bits of coverage per pixel. Generated from BDF fonts by
+/// `tools/bdf2font.py`.
+typedef struct
+{
+    const uint8_t* bitmap;  // Packed glyph bitmaps
+    const glyph_t* glyphs;  // Glyphs from first to last
+    uint8_t        first;   // First character
+    uint8_t        last;    // Last character
+    uint8_t        height;  // Line height
+    uint8_t        bpp;     // Bits per pixel, 1, 2 or 4. 0 - 1
+} font_t;
+
 /// \brief Initialize ST7735
 void tft_init(void);
 
+/// \brief Check Whether a DMA Transfer Is in Progress
+/// \return 1 if queued pixel data is still being sent, 0 otherwise.
+uint8_t tft_busy(void);
+
+/// \brief Wait for All Queued DMA Transfers
+void tft_wait(void);
+
 /// \brief Set Cursor Position for Print Functions
 /// \param x X coordinate, from left to right.
 /// \param y Y coordinate, from top to bottom.
-void tft_set_cursor(uint16_t x, uint16_t y);
+void tft_set_cursor(int16_t x, int16_t y);
 
 /// \brief Set Text Color
 /// \param color Text color
@@ -67,6 +151,18 @@ void tft_set_color(uint16_t color);
 /// \param color Text background color
 void tft_set_background_color(uint16_t color);
 
+/// \brief Set Text Background Transparent
+/// \param transparent 1 - Only draw the text pixels, 0 - Also draw the background.
+void tft_set_transparent(uint8_t transparent);
+
+/// \brief Set Text Font
+/// \param font Proportional font, 0 - Built-in 5x7 font
+void tft_set_font(const font_t* font);
+
+/// \brief Set Text Size
+/// \param size Integer scale factor of the font, 1 - 5x7 pixels
+void tft_set_text_size(uint8_t size);
+
 /// \brief Print a Character
 /// \param c Character to print
 void tft_print_char(char c);
@@ -75,6 +171,23 @@ void tft_print_char(char c);
 /// \param str String to print
 void tft_print(const char* str);
 
+/// \brief Get the Size of a String
+/// \param str String
+/// \param width Width of the printed text
+/// \param height Height of the text line
+void tft_text_extent(const char* str, uint16_t* width, uint16_t* height);
+
+/// \brief Print Text in a Box
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param h Height
+/// \param str Text, wrapped at spaces and '\n'.
+/// \param align Horizontal TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER or
+/// TEXT_ALIGN_RIGHT, or-ed with vertical TEXT_ALIGN_TOP, TEXT_ALIGN_MIDDLE or
+/// TEXT_ALIGN_BOTTOM.
+void tft_print_box(int16_t x, int16_t y, uint16_t w, uint16_t h, const char* str, uint8_t align);
+
 /// \brief Print an Integer
 /// \param num Number to print
 /// \param width Expected width of the number.
@@ -82,11 +195,63 @@ void tft_print(const char* str);
 /// Align right if it is greater than the width of the number.
 void tft_print_number(int32_t num, uint16_t width);
 
+/// \brief Print an Integer Padded with Zeros
+/// \param num Number to print
+/// \param digits Minimum number of digits, up to 10.
+void tft_print_number_padded(int32_t num, uint8_t digits);
+
+/// \brief Print a Fixed-Point Number
+/// \param value Number to print, scaled by 10 to the power of `frac_digits`.
+/// \param frac_digits Number of digits after the decimal point, up to 9.
+void tft_print_fixed(int32_t value, uint8_t frac_digits);
+
+/// \brief Print a Hexadecimal Number
+/// \param num Number to print
+/// \param digits Minimum number of digits, padded with zeros, up to 8.
+void tft_print_hex(uint32_t num, uint8_t digits);
+
+/// \brief Print Formatted Text
+/// \param format Format string, supports %d, %u, %x, %X, %s, %c and %%, with
+/// an optional `-` (align left) or `0` (pad numbers with zeros) flag and a
+/// width.
+void tft_printf(const char* format, ...);
+
+/// \brief Start a Text Console
+/// \details Clears the screen. Uses the current font, size and colors.
+void tft_console_begin(void);
+
+/// \brief Stop the Text Console
+void tft_console_end(void);
+
+/// \brief Print a Character to the Console
+/// \param c Character, '\n' starts a new line and '\r' returns to the start
+/// of the line.
+void tft_console_putc(char c);
+
+/// \brief Print a String to the Console
+/// \param str String
+void tft_console_print(const char* str);
+
+/// \brief Start a New Console Line
+void tft_console_newline(void);
+
 /// \brief Draw a Pixel
 /// \param x X
 /// \param y Y
 /// \param color Pixel color
-void tft_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
+void tft_draw_pixel(int16_t x, int16_t y, uint16_t color);
+
+/// \brief Draw Pixels
+/// \param points Points, sort by row then column to merge more pixels.
+/// \param n Number of points
+/// \param color Pixel color
+void tft_draw_pixels(const point_t* points, uint16_t n, uint16_t color);
+
+/// \brief Draw Pixels in Different Colors
+/// \param points Points, sort by row then column to merge more pixels.
+/// \param colors Pixel colors, one for each point.
+/// \param n Number of points
+void tft_draw_pixels_colors(const point_t* points, const uint16_t* colors, uint16_t n);
 
 /// \brief Draw a Line
 /// \param x0 Start X coordinate
@@ -96,13 +261,59 @@ void tft_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 /// \param color Line color
 void tft_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
 
+/// \brief Draw an Anti-Aliased Line
+/// \param x0 Start X coordinate
+/// \param y0 Start Y coordinate
+/// \param x1 End X coordinate
+/// \param y1 End Y coordinate
+/// \param color Line color
+/// \param bg_color Background color to blend with
+void tft_draw_line_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg_color);
+
+/// \brief Draw a Triangle
+/// \param x0 First X coordinate
+/// \param y0 First Y coordinate
+/// \param x1 Second X coordinate
+/// \param y1 Second Y coordinate
+/// \param x2 Third X coordinate
+/// \param y2 Third Y coordinate
+/// \param color Line color
+void tft_draw_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+/// \brief Fill a Triangle
+/// \param x0 First X coordinate
+/// \param y0 First Y coordinate
+/// \param x1 Second X coordinate
+/// \param y1 Second Y coordinate
+/// \param x2 Third X coordinate
+/// \param y2 Third Y coordinate
+/// \param color Fill color
+void tft_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+/// \brief Fill a Polygon, Even-Odd Rule
+/// \param points Vertices, the last one connects back to the first.
+/// \param n Number of vertices
+/// \param color Fill color
+/// \details Self-intersecting and non-convex polygons are supported. At most
+/// 16 edges may cross the same row of the screen, a polygon with more is not
+/// drawn at all.
+void tft_fill_polygon(const point_t* points, uint16_t n, uint16_t color);
+
+/// \brief Fill a Polygon, Non-Zero Winding Rule
+/// \param points Vertices, the last one connects back to the first.
+/// \param n Number of vertices
+/// \param color Fill color
+/// \details At most 16 edges may cross the same row of the screen, a polygon
+/// with more is not drawn at all.
+void tft_fill_polygon_non_zero(const point_t* points, uint16_t n, uint16_t color);
+
 /// \brief Draw a Rectangle
 /// \param x Start X coordinate
 /// \param y Start Y coordinate
 /// \param width Width
 /// \param height Height
 /// \param color Rectangle Color
-void tft_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
+void tft_draw_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color);
 
 /// \brief Fill a Rectangle Area
 /// \param x Start X coordinate
@@ -110,7 +321,46 @@ void tft_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint
 /// \param width Width
 /// \param height Height
 /// \param color Fill Color
-void tft_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
+void tft_fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color);
+
+/// \brief Draw a Rounded Rectangle
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param radius Corner radius, 0 for square corners.
+/// \param thickness Outline thickness, grows inward.
+/// \param color Line color
+void tft_draw_round_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t radius, uint16_t thickness, uint16_t color);
+
+/// \brief Fill a Rounded Rectangle
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param radius Corner radius
+/// \param color Fill color
+void tft_fill_round_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t radius, uint16_t color);
+
+/// \brief Fill a Rectangle with a Horizontal Gradient
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param color0 Left color
+/// \param color1 Right color
+/// \param dither Ordered dithering of the columns if non-zero
+void tft_fill_gradient_h(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color0, uint16_t color1, uint8_t dither);
+
+/// \brief Fill a Rectangle with a Vertical Gradient
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param color0 Top color
+/// \param color1 Bottom color
+/// \param dither Ordered dithering of the rows if non-zero
+void tft_fill_gradient_v(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color0, uint16_t color1, uint8_t dither);
 
 /// \brief Draw a Bitmap
 /// \param x Start X coordinate
@@ -118,6 +368,94 @@ void tft_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint
 /// \param width Width
 /// \param height Height
 /// \param bitmap Bitmap
-void tft_draw_bitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* bitmap);
+void tft_draw_bitmap(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* bitmap);
+
+/// \brief Fill a Rectangle with a Repeating Tile
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param tile Tile, same format as a bitmap
+/// \param tw Tile width
+/// \param th Tile height
+void tft_fill_pattern(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* tile, uint16_t tw, uint16_t th);
+
+/// \brief Draw a Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Circle color
+void tft_draw_circle(int16_t x, int16_t y, uint16_t r, uint16_t color);
+
+/// \brief Fill a Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Fill color
+void tft_fill_circle(int16_t x, int16_t y, uint16_t r, uint16_t color);
+
+/// \brief Draw an Ellipse
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param rx Horizontal radius
+/// \param ry Vertical radius
+/// \param color Ellipse color
+void tft_draw_ellipse(int16_t x, int16_t y, uint16_t rx, uint16_t ry, uint16_t color);
+
+/// \brief Fill an Ellipse
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param rx Horizontal radius
+/// \param ry Vertical radius
+/// \param color Fill color
+void tft_fill_ellipse(int16_t x, int16_t y, uint16_t rx, uint16_t ry, uint16_t color);
+
+/// \brief Draw an Anti-Aliased Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Circle color
+/// \param bg_color Background color to blend with
+void tft_draw_circle_aa(int16_t x, int16_t y, uint16_t r, uint16_t color, uint16_t bg_color);
+
+/// \brief Draw an Arc
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Arc color
+void tft_draw_arc(int16_t x, int16_t y, uint16_t r, int16_t start, int16_t end, uint16_t color);
+
+/// \brief Fill a Thick Arc
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Outer radius
+/// \param ir Inner radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Fill color
+void tft_fill_arc(int16_t x, int16_t y, uint16_t r, uint16_t ir, int16_t start, int16_t end, uint16_t color);
+
+/// \brief Fill a Pie Slice
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Fill color
+void tft_fill_pie(int16_t x, int16_t y, uint16_t r, int16_t start, int16_t end, uint16_t color);
+
+/// \brief Draw a Ring Gauge
+/// \param ring Ring gauge, its scale is set.
+/// \param value Value
+void tft_draw_ring(ring_t* ring, uint16_t value);
+
+/// \brief Update a Ring Gauge
+/// \param ring Ring gauge, drawn with tft_draw_ring() before.
+/// \param old_value Value shown now
+/// \param new_value Value to show
+/// \details Only the sector between the two values is redrawn.
+void tft_update_ring(const ring_t* ring, uint16_t old_value, uint16_t new_value);
 
 #endif  // __ST7735_H__
@@ -158,12 +158,9 @@ int main(void)
         uint8_t x = 0, y = 0, step_x = 1, step_y = 1;
         while (frame-- > 0)
         {
-            uint16_t bg = colors[rand8() % 19];
-            tft_fill_rect(x, y, 88, 17, bg);
+            tft_set_background_color(colors[rand8() % 19]);
             tft_set_color(colors[rand8() % 19]);
-            tft_set_background_color(bg);
-            tft_set_cursor(x + 5, y + 5);
-            tft_print("Hello, World!");
+            tft_print_box(x, y, 88, 17, "Hello, World!", TEXT_ALIGN_CENTER | TEXT_ALIGN_MIDDLE);
             Delay_Ms(25);
 
             x += step_x;
@@ -15,6 +15,8 @@
 
 #include "st7735.h"
 
+#include <stdarg.h>
+
 #ifdef PLATFORMIO  // Use PlatformIO CH32V
     #include <debug.h>
 #else  // Use ch32v003fun
@@ -32,16 +34,29 @@
 #define SPI_SCLK 5  // PC5
 #define SPI_MOSI 6  // PC6
 
-#define DATA_MODE()    (GPIOC->BSHR |= 1 << PIN_DC)  // DC High
-#define COMMAND_MODE() (GPIOC->BCR |= 1 << PIN_DC)   // DC Low
-#define RESET_HIGH()   (GPIOC->BSHR |= 1 << PIN_RESET)
-#define RESET_LOW()    (GPIOC->BCR |= 1 << PIN_RESET)
+#define DC_HIGH()    (GPIOC->BSHR |= 1 << PIN_DC)  // DC High - Data
+#define DC_LOW()     (GPIOC->BCR |= 1 << PIN_DC)   // DC Low - Command
+#define RESET_HIGH() (GPIOC->BSHR |= 1 << PIN_RESET)
+#define RESET_LOW()  (GPIOC->BCR |= 1 << PIN_RESET)
 #ifndef ST7735_NO_CS
-    #define START_WRITE() (GPIOC->BCR |= 1 << PIN_CS)   // CS Low
-    #define END_WRITE()   (GPIOC->BSHR |= 1 << PIN_CS)  // CS High
+    #define CS_LOW()  (GPIOC->BCR |= 1 << PIN_CS)   // CS Low
+    #define CS_HIGH() (GPIOC->BSHR |= 1 << PIN_CS)  // CS High
 #else
-    #define START_WRITE()
-    #define END_WRITE()
+    #define CS_LOW()  ((void)0)
+    #define CS_HIGH() ((void)0)
+#endif
+
+// DC and CS only change after the last byte has been shifted out
+#define DATA_MODE()    SPI_set_dc(1)
+#define COMMAND_MODE() SPI_set_dc(0)
+#ifndef ST7735_DMA_ASYNC
+    #define START_WRITE() CS_LOW()
+    #define END_WRITE()   (SPI_wait_idle(), CS_HIGH())
+    #define DMA_MODE      DMA_Mode_Circular  // Repeat the buffer by polling
+#else  // The queued DMA transfers must be done as well
+    #define START_WRITE() (tft_wait(), CS_LOW())
+    #define END_WRITE()   DMA_end_write()
+    #define DMA_MODE      (DMA_Mode_Normal | DMA_IT_TC)  // Single pass, re-armed by interrupt
 #endif
 
 // PlatformIO Compatibility
@@ -57,6 +72,9 @@
 #define ST7735_RST_DELAY    50   // delay ms wait for reset finish
 #define ST7735_SLPOUT_DELAY 120  // delay ms wait for sleep out finish
 
+// Frame memory rows, along the vertical scroll axis of the panel
+#define ST7735_GRAM_ROWS 162
+
 // System Function Command List - Write Commands Only
 #define ST7735_SLPIN   0x10  // Sleep IN
 #define ST7735_SLPOUT  0x11  // Sleep Out
@@ -71,9 +89,11 @@
 #define ST7735_RASET   0x2B  // Row Address Set
 #define ST7735_RAMWR   0x2C  // Memory Write
 #define ST7735_PLTAR   0x30  // Partial Area
+#define ST7735_VSCRDEF 0x33  // Vertical Scrolling Definition
 #define ST7735_TEOFF   0x34  // Tearing Effect Line Off
 #define ST7735_TEON    0x35  // Tearing Effect Line On
 #define ST7735_MADCTL  0x36  // Memory Data Access Control
+#define ST7735_VSCSAD  0x37  // Vertical Scroll Start Address of RAM
 #define ST7735_IDMOFF  0x38  // Idle Mode Off
 #define ST7735_IDMON   0x39  // Idle Mode On
 #define ST7735_COLMOD  0x3A  // Interface Pixel Format
@@ -94,15 +114,84 @@
 // COLMOD Parameter
 #define ST7735_COLMOD_16_BPP 0x05  // 101 - 16-bit/pixel
 
+// Runs longer than this are sent by DMA in fill mode
+#define FILL_DMA_MIN 4
+
+// Polygon edges crossing one scanline, 12 bytes of stack each
+#define POLYGON_MAX_EDGES 16
+
+// Anti-aliasing, blend levels between background (0) and color (AA_LEVELS)
+#define AA_SHIFT   3
+#define AA_LEVELS  (1 << AA_SHIFT)
+#define AA_RUN_MAX 16  // Pixels buffered before a window is written
+
 // 5x7 Font
 #define FONT_WIDTH  5  // Font width
 #define FONT_HEIGHT 7  // Font height
 
-static uint16_t _cursor_x                  = 0;
-static uint16_t _cursor_y                  = 0;      // Cursor position (x, y)
+// tft_printf() characters buffered on the stack before they are drawn
+#define PRINTF_CHUNK 16
+
+static int16_t  _cursor_x                  = 0;
+static int16_t  _cursor_y                  = 0;      // Cursor position (x, y)
 static uint16_t _color                     = WHITE;  // Color
 static uint16_t _bg_color                  = BLACK;  // Background color
+static uint8_t  _transparent               = 0;      // Text background is not drawn
+static uint8_t  _text_size                 = 1;      // Integer scale of the font
+static const font_t* _font                 = 0;      // Proportional font, 0 - Built-in 5x7 font
 static uint8_t  _buffer[ST7735_WIDTH << 1] = {0};    // DMA buffer, long enough to fill a row.
+static uint16_t _fill_color                = 0;      // DMA source of solid fills
+static uint8_t  _dc                        = 0;      // Level of the DC line, 0 - Command, 1 - Data
+
+// Anti-aliasing blend table, rebuilt when the color pair changes.
+static uint16_t _aa_lut[AA_LEVELS + 1] = {0};
+static uint16_t _aa_color              = BLACK;
+static uint16_t _aa_bg_color           = BLACK;  // Color pair of the table
+
+// Anti-aliased text blend table, rebuilt when the text colors change.
+#define TEXT_LEVELS 16  // Levels of 4bpp glyphs, 1bpp and 2bpp are expanded.
+static uint16_t _text_lut[TEXT_LEVELS] = {0};
+static uint16_t _text_lut_color        = BLACK;
+static uint16_t _text_lut_bg_color     = BLACK;  // Color pair of the table
+
+// Text console, see tft_console_begin()
+static int16_t _console_line_h  = 0;  // Line height
+static uint8_t _console_lines   = 0;  // Lines on the screen, 0 - Not started
+static uint8_t _console_line    = 0;  // Line of the cursor, from the top of the screen
+static int16_t _console_x       = 0;  // Cursor X
+static int16_t _console_height  = 0;  // Height of the whole lines, the scroll area
+static int16_t _console_scroll  = 0;  // Memory row at the top of the screen
+static uint8_t _console_wrapped = 0;  // Lines below the cursor hold old text
+
+// Address window cache, CASET/RASET are only sent when changed.
+#define WINDOW_INVALID 0xFFFF  // Never a valid address, forces the next CASET/RASET
+static uint16_t _window_x0 = WINDOW_INVALID;
+static uint16_t _window_x1 = WINDOW_INVALID;  // Last column range
+static uint16_t _window_y0 = WINDOW_INVALID;
+static uint16_t _window_y1 = WINDOW_INVALID;  // Last row range
+
+#ifdef ST7735_DMA_ASYNC
+// DMA transfer queue, must be a power of 2
+    #define DMA_QUEUE_SIZE 4
+    #define DMA_QUEUE_MASK (DMA_QUEUE_SIZE - 1)
+
+typedef struct
+{
+    const uint8_t* buffer;  // Memory address
+    uint16_t       size;    // Memory size
+    uint16_t       repeat;  // Repeat times
+    uint8_t        fill;    // Send a 16-bit word repeatedly, see SPI_set_fill_mode()
+} dma_transfer_t;
+
+static volatile dma_transfer_t _dma_queue[DMA_QUEUE_SIZE];  // Pending transfers
+static volatile uint8_t        _dma_head        = 0;        // Next transfer to start, owned by the interrupt
+static volatile uint8_t        _dma_tail        = 0;        // Next free slot, owned by the caller
+static volatile uint8_t        _dma_busy        = 0;        // A transfer is in progress
+static volatile uint8_t        _dma_end_pending = 0;        // Raise CS once the queue is drained
+static volatile uint16_t       _dma_size        = 0;        // Size of the current transfer
+static volatile uint16_t       _dma_repeat      = 0;        // Remaining repeat times of the current transfer
+static volatile uint8_t        _dma_fill        = 0;        // SPI and DMA are in fill mode
+#endif
 
 /// \brief Initialize ST7735
 /// \details Configure SPI, DMA, and RESET/DC/CS lines.
@@ -151,7 +240,7 @@ static void SPI_init(void)
 
     // Config DMA for SPI TX
     DMA1_Channel3->CFGR = DMA_DIR_PeripheralDST          // Bit 4     - Read from memory
-                          | DMA_Mode_Circular            // Bit 5     - Circulation mode
+                          | DMA_MODE                     // Bit 1, 5  - Circulation mode or TC interrupt
                           | DMA_PeripheralInc_Disable    // Bit 6     - Peripheral address no change
                           | DMA_MemoryInc_Enable         // Bit 7     - Increase memory address
                           | DMA_PeripheralDataSize_Byte  // Bit 8-9   - 8-bit data
@@ -159,8 +248,188 @@ static void SPI_init(void)
                           | DMA_Priority_VeryHigh        // Bit 12-13 - Very high priority
                           | DMA_M2M_Disable;             // Bit 14    - Disable memory to memory mode
     DMA1_Channel3->PADDR = (uint32_t)&SPI1->DATAR;
+
+    DC_LOW();
+    _dc = 0;
+
+#ifdef ST7735_DMA_ASYNC
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+    __enable_irq();
+#endif
+}
+
+/// \brief Wait for SPI to Be Idle
+/// \details Returns after the last byte has left the shift register.
+static void SPI_wait_idle(void)
+{
+    while (!(SPI1->STATR & SPI_STATR_TXE))
+        ;
+    while (SPI1->STATR & SPI_STATR_BSY)
+        ;
+}
+
+/// \brief Switch Between Buffer Mode and Fill Mode
+/// \param fill 0 - Send a byte buffer, 8-bit SPI frames, 8-bit DMA with increasing memory address.
+///             1 - Send a 16-bit word repeatedly, 16-bit SPI frames, 16-bit DMA from a fixed address.
+/// \details The SPI data frame format can only be changed while SPI is idle and disabled.
+static void SPI_set_fill_mode(uint8_t fill)
+{
+    SPI_wait_idle();
+
+    SPI1->CTLR1 &= ~CTLR1_SPE_Set;
+    if (fill)
+    {
+        SPI1->CTLR1 |= SPI_DataSize_16b;
+        DMA1_Channel3->CFGR = (DMA1_Channel3->CFGR & ~(DMA_CFGR1_MINC | DMA_CFGR1_CIRC))  // Fixed address, single pass
+                              | DMA_PeripheralDataSize_HalfWord                          // 16-bit data
+                              | DMA_MemoryDataSize_HalfWord;                             // 16-bit data
+    }
+    else
+    {
+        SPI1->CTLR1 &= ~SPI_DataSize_16b;
+        DMA1_Channel3->CFGR = (DMA1_Channel3->CFGR & ~(DMA_CFGR1_PSIZE | DMA_CFGR1_MSIZE))  // 8-bit data
+                              | DMA_MemoryInc_Enable                                       // Increase memory address
+                              | DMA_MODE;
+    }
+    SPI1->CTLR1 |= CTLR1_SPE_Set;
+}
+
+#ifdef ST7735_DMA_ASYNC
+/// \brief Start the Transfer at the Head of the Queue
+/// \details Called with the DMA interrupt masked or from the interrupt itself.
+static void DMA_start_next(void)
+{
+    volatile dma_transfer_t* t = &_dma_queue[_dma_head];
+    _dma_head                  = (_dma_head + 1) & DMA_QUEUE_MASK;
+    _dma_size                  = t->size;
+    _dma_repeat                = t->repeat;
+    _dma_busy                  = 1;
+
+    if (t->fill != _dma_fill)
+    {
+        _dma_fill = t->fill;
+        SPI_set_fill_mode(t->fill);
+    }
+
+    DMA1_Channel3->MADDR = (uint32_t)t->buffer;
+    DMA1_Channel3->CNTR  = t->size;
+    DMA1_Channel3->CFGR |= DMA_CFGR1_EN;  // Turn on channel
+}
+
+    #ifdef PLATFORMIO
+void DMA1_Channel3_IRQHandler(void) __attribute__((interrupt("WCH-Interrupt-fast")));
+    #else
+void DMA1_Channel3_IRQHandler(void) __attribute__((interrupt));
+    #endif
+
+/// \brief DMA1 Channel 3 Transfer Complete Interrupt
+/// \details Re-arm the channel for the remaining repeats, then start the next
+/// queued transfer. CS is raised only after the last byte has left the shift
+/// register.
+void DMA1_Channel3_IRQHandler(void)
+{
+    DMA1->INTFCR = DMA1_IT_GL3;            // Clear all channel 3 flags
+    DMA1_Channel3->CFGR &= ~DMA_CFGR1_EN;  // Turn off channel
+
+    if (--_dma_repeat)
+    {
+        DMA1_Channel3->CNTR = _dma_size;
+        DMA1_Channel3->CFGR |= DMA_CFGR1_EN;  // Send the buffer again
+        return;
+    }
+
+    if (_dma_head != _dma_tail)
+    {
+        DMA_start_next();
+        return;
+    }
+
+    // Queue drained, wait for the last byte
+    SPI_wait_idle();
+
+    if (_dma_fill)
+    {
+        _dma_fill = 0;
+        SPI_set_fill_mode(0);
+    }
+
+    if (_dma_end_pending)
+    {
+        _dma_end_pending = 0;
+        CS_HIGH();
+    }
+
+    _dma_busy = 0;
+}
+
+/// \brief End a Write Transaction
+/// \details Raise CS now, or let the interrupt raise it when the queue is drained.
+static void DMA_end_write(void)
+{
+    NVIC_DisableIRQ(DMA1_Channel3_IRQn);
+    if (_dma_busy)
+    {
+        _dma_end_pending = 1;
+    }
+    else
+    {
+        SPI_wait_idle();
+        CS_HIGH();
+    }
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+}
+
+/// \brief Queue a DMA Transfer
+/// \param buffer Memory address, must stay valid until the transfer is done
+/// \param size Memory size, in bytes or in 16-bit words in fill mode
+/// \param repeat Repeat times
+/// \param fill Fill mode, see SPI_set_fill_mode()
+/// \details Returns as soon as the transfer is queued. Waits only if the queue is full.
+static void DMA_queue(const uint8_t* buffer, uint16_t size, uint16_t repeat, uint8_t fill)
+{
+    if (!size || !repeat)
+    {
+        return;
+    }
+
+    uint8_t next = (_dma_tail + 1) & DMA_QUEUE_MASK;
+    while (next == _dma_head)
+        ;
+
+    volatile dma_transfer_t* t = &_dma_queue[_dma_tail];
+    t->buffer                  = buffer;
+    t->size                    = size;
+    t->repeat                  = repeat;
+    t->fill                    = fill;
+
+    NVIC_DisableIRQ(DMA1_Channel3_IRQn);
+    _dma_tail = next;
+    if (!_dma_busy)
+    {
+        DMA_start_next();
+    }
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+}
+
+/// \brief Queue Data to Send Through SPI via DMA
+/// \param buffer Memory address, must stay valid until the transfer is done
+/// \param size Memory size
+/// \param repeat Repeat times
+static void SPI_send_DMA(const uint8_t* buffer, uint16_t size, uint16_t repeat)
+{
+    DMA_queue(buffer, size, repeat, 0);
 }
 
+/// \brief Queue a Color to Send Repeatedly Through SPI via DMA
+/// \param color 16-bit color
+/// \param count Number of pixels
+static void SPI_fill_DMA(uint16_t color, uint16_t count)
+{
+    tft_wait();  // _fill_color may still be queued
+    _fill_color = color;
+    DMA_queue((const uint8_t*)&_fill_color, count, 1, 1);
+}
+#else
 /// \brief Send Data Through SPI via DMA
 /// \param buffer Memory address
 /// \param size Memory size
@@ -185,16 +454,87 @@ static void SPI_send_DMA(const uint8_t* buffer, uint16_t size, uint16_t repeat)
     DMA1_Channel3->CFGR &= ~DMA_CFGR1_EN;  // Turn off channel
 }
 
+/// \brief Send a Color Repeatedly Through SPI via DMA
+/// \param color 16-bit color
+/// \param count Number of pixels
+/// \details The whole area is sent in one transfer of 16-bit frames from a fixed
+/// address, no buffer is prepared and no CPU work is done per row.
+static void SPI_fill_DMA(uint16_t color, uint16_t count)
+{
+    _fill_color = color;
+    SPI_set_fill_mode(1);
+
+    DMA1_Channel3->MADDR = (uint32_t)&_fill_color;
+    DMA1_Channel3->CNTR  = count;
+    DMA1->INTFCR         = DMA1_FLAG_TC3;
+    DMA1_Channel3->CFGR |= DMA_CFGR1_EN;  // Turn on channel
+
+    // Waiting for channel 3 transmission complete
+    while (!(DMA1->INTFR & DMA1_FLAG_TC3))
+        ;
+
+    DMA1_Channel3->CFGR &= ~DMA_CFGR1_EN;  // Turn off channel
+    SPI_set_fill_mode(0);
+}
+#endif
+
+/// \brief Check Whether a DMA Transfer Is in Progress
+/// \return 1 if queued pixel data is still being sent, 0 otherwise.
+uint8_t tft_busy(void)
+{
+#ifdef ST7735_DMA_ASYNC
+    return _dma_busy;
+#else
+    return 0;
+#endif
+}
+
+/// \brief Wait for All Queued DMA Transfers
+/// \details Returns after the last byte has left the SPI shift register.
+void tft_wait(void)
+{
+#ifdef ST7735_DMA_ASYNC
+    while (_dma_busy)
+        ;
+#endif
+}
+
+/// \brief Set DC Line
+/// \param dc 0 - Command, 1 - Data
+/// \details Only waits for SPI to be idle when DC actually changes, so
+/// consecutive commands or data bytes are sent back to back.
+static void SPI_set_dc(uint8_t dc)
+{
+    if (dc == _dc)
+    {
+        return;
+    }
+
+    tft_wait();
+    SPI_wait_idle();
+    if (dc)
+    {
+        DC_HIGH();
+    }
+    else
+    {
+        DC_LOW();
+    }
+    _dc = dc;
+}
+
 /// \brief Send Data Directly Through SPI
 /// \param data 8-bit data
+/// \details Waits for the transmit buffer only, the previous byte may still be
+/// shifting out. Use SPI_wait_idle() before changing DC or CS.
 static void SPI_send(uint8_t data)
 {
-    // Send byte
-    SPI1->DATAR = data;
-
-    // Waiting for transmission complete
+    // Waiting for transmit buffer empty
     while (!(SPI1->STATR & SPI_STATR_TXE))
         ;
+
+    // Send byte
+    SPI1->DATAR = data;
 }
 
 /// \brief Send 8-Bit Command
@@ -205,6 +545,20 @@ static void write_command_8(uint8_t cmd)
     SPI_send(cmd);
 }
 
+/// \brief Send a Command with Parameters
+/// \param cmd 8-bit command
+/// \param data Parameters
+/// \param size Number of parameters
+static void write_command(uint8_t cmd, const uint8_t* data, uint8_t size)
+{
+    write_command_8(cmd);
+    DATA_MODE();
+    while (size--)
+    {
+        SPI_send(*data++);
+    }
+}
+
 /// \brief Send 8-Bit Data
 /// \param cmd 8-bit data
 static void write_data_8(uint8_t data)
@@ -222,6 +576,37 @@ static void write_data_16(uint16_t data)
     SPI_send(data);
 }
 
+/// \brief Send a Color Repeatedly
+/// \param color 16-bit color
+/// \param count Number of pixels
+/// \details Short runs are written directly, switching SPI and DMA to fill mode
+/// costs more than sending a few pixels.
+static void write_color(uint16_t color, uint16_t count)
+{
+    DATA_MODE();
+    if (count > FILL_DMA_MIN)
+    {
+        SPI_fill_DMA(color, count);
+        return;
+    }
+
+    while (count--)
+    {
+        SPI_send(color >> 8);
+        SPI_send(color);
+    }
+}
+
+/// \brief Invalidate Address Window Cache
+/// \details Call after reset, and whenever MADCTL or the sleep mode is changed.
+static void tft_invalidate_window(void)
+{
+    _window_x0 = WINDOW_INVALID;
+    _window_x1 = WINDOW_INVALID;
+    _window_y0 = WINDOW_INVALID;
+    _window_y1 = WINDOW_INVALID;
+}
+
 /// \brief Initialize ST7735
 /// \details Initialization sequence from Arduino_GFX
 /// https://github.com/moononournation/Arduino_GFX/blob/master/src/display/Arduino_ST7735.h
@@ -234,6 +619,7 @@ void tft_init(void)
     Delay_Ms(ST7735_RST_DELAY);
     RESET_HIGH();
     Delay_Ms(ST7735_RST_DELAY);
+    tft_invalidate_window();
 
     START_WRITE();
 
@@ -243,8 +629,11 @@ void tft_init(void)
 
     // Set rotation
     write_command_8(ST7735_MADCTL);
+#ifndef ST7735_VERTICAL
     write_data_8(ST7735_MADCTL_MY | ST7735_MADCTL_MV | ST7735_MADCTL_BGR);  // 0 - Horizontal
-    // write_data_8(ST7735_MADCTL_BGR);                                        // 1 - Vertical
+#else
+    write_data_8(ST7735_MADCTL_BGR);  // 1 - Vertical
+#endif
     // write_data_8(ST7735_MADCTL_MX | ST7735_MADCTL_MV | ST7735_MADCTL_BGR);  // 2 - Horizontal
     // write_data_8(ST7735_MADCTL_MX | ST7735_MADCTL_MY | ST7735_MADCTL_BGR);  // 3 - Vertical
 
@@ -254,19 +643,15 @@ void tft_init(void)
 
     // Gamma Adjustments (pos. polarity), 16 args.
     // (Not entirely necessary, but provides accurate colors)
-    uint8_t gamma_p[] = {0x09, 0x16, 0x09, 0x20, 0x21, 0x1B, 0x13, 0x19,
-                         0x17, 0x15, 0x1E, 0x2B, 0x04, 0x05, 0x02, 0x0E};
-    write_command_8(ST7735_GMCTRP1);
-    DATA_MODE();
-    SPI_send_DMA(gamma_p, 16, 1);
+    static const uint8_t gamma_p[] = {0x09, 0x16, 0x09, 0x20, 0x21, 0x1B, 0x13, 0x19,
+                                      0x17, 0x15, 0x1E, 0x2B, 0x04, 0x05, 0x02, 0x0E};
+    write_command(ST7735_GMCTRP1, gamma_p, sizeof(gamma_p));
 
     // Gamma Adjustments (neg. polarity), 16 args.
     // (Not entirely necessary, but provides accurate colors)
-    uint8_t gamma_n[] = {0x0B, 0x14, 0x08, 0x1E, 0x22, 0x1D, 0x18, 0x1E,
-                         0x1B, 0x1A, 0x24, 0x2B, 0x06, 0x06, 0x02, 0x0F};
-    write_command_8(ST7735_GMCTRN1);
-    DATA_MODE();
-    SPI_send_DMA(gamma_n, 16, 1);
+    static const uint8_t gamma_n[] = {0x0B, 0x14, 0x08, 0x1E, 0x22, 0x1D, 0x18, 0x1E,
+                                      0x1B, 0x1A, 0x24, 0x2B, 0x06, 0x06, 0x02, 0x0F};
+    write_command(ST7735_GMCTRN1, gamma_n, sizeof(gamma_n));
 
     Delay_Ms(10);
 
@@ -285,14 +670,42 @@ void tft_init(void)
     END_WRITE();
 }
 
+/// \brief Build the Anti-Aliased Text Blend Table
+/// \details Level i is `_bg_color` blended with `_color` by i / 15. Channels
+/// are interpolated by accumulating 17 / 256 steps, no multiplication.
+/// Nothing is done if the text colors are unchanged.
+static void _tft_text_lut(void)
+{
+    if (_color == _text_lut_color && _bg_color == _text_lut_bg_color)
+    {
+        return;
+    }
+    _text_lut_color    = _color;
+    _text_lut_bg_color = _bg_color;
+
+    int16_t r = _bg_color >> 11, g = (_bg_color >> 5) & 0x3F, b = _bg_color & 0x1F;
+    int16_t dr = (_color >> 11) - r, dg = ((_color >> 5) & 0x3F) - g, db = (_color & 0x1F) - b;
+    dr = (dr << 4) + dr;  // x 17
+    dg = (dg << 4) + dg;
+    db = (db << 4) + db;
+    int16_t ar = 128, ag = 128, ab = 128;  // Rounding
+    for (uint8_t i = 0; i < TEXT_LEVELS; i++)
+    {
+        _text_lut[i] = ((r + (ar >> 8)) << 11) | ((g + (ag >> 8)) << 5) | (b + (ab >> 8));
+        ar += dr;
+        ag += dg;
+        ab += db;
+    }
+}
+
 /// \brief Set Cursor Position for Print Functions
 /// \param x X coordinate, from left to right.
 /// \param y Y coordinate, from top to bottom.
-/// \details Calculate offset and set to `_cursor_x` and `_cursor_y` variables
-void tft_set_cursor(uint16_t x, uint16_t y)
+/// \details Set to `_cursor_x` and `_cursor_y` variables
+void tft_set_cursor(int16_t x, int16_t y)
 {
-    _cursor_x = x + ST7735_X_OFFSET;
-    _cursor_y = y + ST7735_Y_OFFSET;
+    _cursor_x = x;
+    _cursor_y = y;
 }
 
 /// \brief Set Text Color
@@ -301,6 +714,7 @@ void tft_set_cursor(uint16_t x, uint16_t y)
 void tft_set_color(uint16_t color)
 {
     _color = color;
+    _tft_text_lut();
 }
 
 /// \brief Set Text Background Color
@@ -309,320 +723,3154 @@ void tft_set_color(uint16_t color)
 void tft_set_background_color(uint16_t color)
 {
     _bg_color = color;
+    _tft_text_lut();
 }
 
-/// \brief Set Memory Write Window
-/// \param x0 Start column
-/// \param y0 Start row
-/// \param x1 End column
-/// \param y1 End row
-static void tft_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+/// \brief Set Text Background Transparent
+/// \param transparent 1 - Only draw the text pixels, 0 - Also draw the background.
+void tft_set_transparent(uint8_t transparent)
 {
-    write_command_8(ST7735_CASET);
-    write_data_16(x0);
-    write_data_16(x1);
-    write_command_8(ST7735_RASET);
-    write_data_16(y0);
-    write_data_16(y1);
-    write_command_8(ST7735_RAMWR);
+    _transparent = transparent;
 }
 
-/// \brief Print a Character
-/// \param c Character to print
-/// \details DMA accelerated.
-void tft_print_char(char c)
+/// \brief Set Text Font
+/// \param font Proportional font, 0 - Built-in 5x7 font
+/// \details The cursor is the top left corner of the text line.
+void tft_set_font(const font_t* font)
 {
-    const unsigned char* start = &font[c + (c << 2)];
-
-    uint16_t sz = 0;
-    for (uint8_t i = 0; i < FONT_HEIGHT; i++)
-    {
-        for (uint8_t j = 0; j < FONT_WIDTH; j++)
-        {
-            if ((*(start + j)) & (0x01 << i))
-            {
-                _buffer[sz++] = _color >> 8;
-                _buffer[sz++] = _color;
-            }
-            else
-            {
-                _buffer[sz++] = _bg_color >> 8;
-                _buffer[sz++] = _bg_color;
-            }
-        }
-    }
-
-    START_WRITE();
-    tft_set_window(_cursor_x, _cursor_y, _cursor_x + FONT_WIDTH - 1, _cursor_y + FONT_HEIGHT - 1);
-    DATA_MODE();
-    SPI_send_DMA(_buffer, sz, 1);
-    END_WRITE();
+    _font = font;
 }
 
-/// \brief Print a String
-/// \param str String to print
-void tft_print(const char* str)
+/// \brief Set Text Size
+/// \param size Integer scale factor of the font, 1 - 5x7 pixels
+void tft_set_text_size(uint8_t size)
 {
-    while (*str)
+    if (size < 1)
+    {
+        size = 1;
+    }
+    if (size > ST7735_WIDTH / (FONT_WIDTH + 1))
     {
-        tft_print_char(*str++);
-        _cursor_x += FONT_WIDTH + 1;
+        size = ST7735_WIDTH / (FONT_WIDTH + 1);  // A character must fit in the buffer
     }
+    _text_size = size;
 }
 
-/// \brief Print an Integer
-/// \param num Number to print
-/// \param width Expected width of the number.
-/// Align left if it is less than the width of the number.
-/// Align right if it is greater than the width of the number.
-void tft_print_number(int32_t num, uint16_t width)
+/// \brief Set Memory Write Window
+/// \param x0 Start column
+/// \param y0 Start row
+/// \param x1 End column
+/// \param y1 End row
+/// \details Column and row ranges are only sent when they differ from the last
+/// window, RAMWR is always sent to reset the memory pointer.
+static void tft_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    static char str[12];
-    uint8_t     position  = 11;
-    uint8_t     negative  = 0;
-    uint16_t    num_width = 0;
+    uint8_t data[4];
 
-    // Handle negative number
-    if (num < 0)
+    if (x0 != _window_x0 || x1 != _window_x1)
     {
-        negative = 1;
-        num      = -num;
+        data[0] = x0 >> 8;
+        data[1] = x0;
+        data[2] = x1 >> 8;
+        data[3] = x1;
+        write_command(ST7735_CASET, data, 4);
+        _window_x0 = x0;
+        _window_x1 = x1;
     }
-
-    str[position] = '\0';  // End of the string.
-    while (num)
+    if (y0 != _window_y0 || y1 != _window_y1)
     {
-        str[--position] = num % 10 + '0';
-        num /= 10;
+        data[0] = y0 >> 8;
+        data[1] = y0;
+        data[2] = y1 >> 8;
+        data[3] = y1;
+        write_command(ST7735_RASET, data, 4);
+        _window_y0 = y0;
+        _window_y1 = y1;
     }
+    write_command_8(ST7735_RAMWR);
+}
 
-    if (position == 11)
+/// \brief Clip a Rectangle to the Screen
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param h Height
+/// \return 0 if nothing is visible.
+static uint8_t _tft_clip_rect(int16_t* x, int16_t* y, int16_t* w, int16_t* h)
+{
+    if (*x < 0)
     {
-        str[--position] = '0';
+        *w += *x;
+        *x = 0;
     }
-
-    if (negative)
+    if (*y < 0)
     {
-        str[--position] = '-';
+        *h += *y;
+        *y = 0;
     }
-
-    // Calculate alignment
-    num_width = (11 - position) * (FONT_WIDTH + 1) - 1;
-    if (width > num_width)
+    if (*x + *w > ST7735_WIDTH)
     {
-        _cursor_x += width - num_width;
+        *w = ST7735_WIDTH - *x;
     }
-
-    tft_print(&str[position]);
+    if (*y + *h > ST7735_HEIGHT)
+    {
+        *h = ST7735_HEIGHT - *y;
+    }
+    return *w > 0 && *h > 0;
 }
 
-/// \brief Draw a Pixel
-/// \param x X
-/// \param y Y
-/// \param color Pixel color
-/// \details SPI direct write
-void tft_draw_pixel(uint16_t x, uint16_t y, uint16_t color)
+/// \brief Set Memory Write Window to a Screen Area
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param h Height
+/// \details Add offset, the area must be on screen.
+static void _tft_set_window_rect(int16_t x, int16_t y, int16_t w, int16_t h)
 {
     x += ST7735_X_OFFSET;
     y += ST7735_Y_OFFSET;
-    START_WRITE();
-    tft_set_window(x, y, x, y);
-    write_data_16(color);
-    END_WRITE();
+    tft_set_window(x, y, x + w - 1, y + h - 1);
 }
 
-/// \brief Fill a Rectangle Area
+/// \brief Write a Filled Rectangle
 /// \param x Start X coordinate
 /// \param y Start Y coordinate
-/// \param width Width
-/// \param height Height
-/// \param color Fill Color
-/// \details DMA accelerated.
-void tft_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+/// \param w Width
+/// \param h Height
+/// \param color Fill color
+/// \details Clipped, DMA accelerated, the caller holds CS.
+static void _tft_write_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 {
-    x += ST7735_X_OFFSET;
-    y += ST7735_Y_OFFSET;
-
-    uint16_t sz = 0;
-    for (uint16_t x = 0; x < width; x++)
+    if (!_tft_clip_rect(&x, &y, &w, &h))
     {
-        _buffer[sz++] = color >> 8;
-        _buffer[sz++] = color;
+        return;
     }
 
-    START_WRITE();
-    tft_set_window(x, y, x + width - 1, y + height - 1);
-    DATA_MODE();
-    SPI_send_DMA(_buffer, sz, height);
-    END_WRITE();
+    _tft_set_window_rect(x, y, w, h);
+    write_color(color, w * h);
 }
 
-/// \brief Draw a Bitmap
+/// \brief Write a Bitmap
 /// \param x Start X coordinate
 /// \param y Start Y coordinate
-/// \param width Width
-/// \param height Height
+/// \param w Width
+/// \param h Height
 /// \param bitmap Bitmap
-void tft_draw_bitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* bitmap)
+/// \details Clipped, only the visible rows and columns are sent. DMA
+/// accelerated, the caller holds CS.
+static void _tft_write_bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bitmap)
 {
-    x += ST7735_X_OFFSET;
-    y += ST7735_Y_OFFSET;
-    START_WRITE();
-    tft_set_window(x, y, x + width - 1, y + height - 1);
-    DATA_MODE();
-    SPI_send_DMA(bitmap, width * height << 1, 1);
-    END_WRITE();
-}
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    if (!_tft_clip_rect(&cx, &cy, &cw, &ch))
+    {
+        return;
+    }
 
-/// \brief Draw a Vertical Line Fast
-/// \param x0 Start X coordinate
-/// \param y0 Start Y coordinate
-/// \param x1 End X coordinate
-/// \param y1 End Y coordinate
-/// \param color Line color
-/// \details DMA accelerated
-static void _tft_draw_fast_v_line(int16_t x, int16_t y, int16_t h, uint16_t color)
-{
-    x += ST7735_X_OFFSET;
-    y += ST7735_Y_OFFSET;
+    _tft_set_window_rect(cx, cy, cw, ch);
+    DATA_MODE();
 
-    uint16_t sz = 0;
-    for (int16_t j = 0; j < h; j++)
+    bitmap += ((cy - y) * w + (cx - x)) << 1;  // First visible pixel
+    if (cw == w)
     {
-        _buffer[sz++] = color >> 8;
-        _buffer[sz++] = color;
+        // Visible rows are contiguous
+        SPI_send_DMA(bitmap, (cw * ch) << 1, 1);
+        return;
     }
 
-    START_WRITE();
-    tft_set_window(x, y, x, y + h - 1);
-    DATA_MODE();
-    SPI_send_DMA(_buffer, sz, 1);
-    END_WRITE();
+    while (ch--)
+    {
+        SPI_send_DMA(bitmap, cw << 1, 1);
+        bitmap += w << 1;
+    }
 }
 
-/// \brief Draw a Horizontal Line Fast
-/// \param x0 Start X coordinate
-/// \param y0 Start Y coordinate
-/// \param x1 End X coordinate
-/// \param y1 End Y coordinate
+/// \brief Write a Transparent Character at the Cursor
+/// \param c Character to write
+/// \details Only the set pixels are drawn. Each glyph column is split into
+/// vertical runs, runs in the same column only change the row range of the
+/// window. The caller holds CS.
+static void _tft_write_char(char c)
+{
+    const unsigned char* start = &font[c + (c << 2)];
+    uint8_t              s     = _text_size;
+    int16_t              x     = _cursor_x;
+
+    for (uint8_t j = 0; j < FONT_WIDTH; j++, x += s)
+    {
+        uint8_t column = start[j] & ((1 << FONT_HEIGHT) - 1);
+        int16_t y      = _cursor_y;
+        while (column)
+        {
+            if (!(column & 0x01))
+            {
+                column >>= 1;
+                y += s;
+                continue;
+            }
+            int16_t len = 0;
+            while (column & 0x01)
+            {
+                column >>= 1;
+                len += s;
+            }
+            _tft_write_fill_rect(x, y, s, len, _color);
+            y += len;
+        }
+    }
+}
+
+/// \brief Write a Scaled String at the Cursor
+/// \param str Characters to write
+/// \param len Number of characters
+/// \param more 1 - More characters follow on the line, the gap after the last
+/// character is written.
+/// \details Each glyph row is expanded once into the DMA buffer and repeated
+/// by DMA for the scaled row height, so the CPU work does not grow with the
+/// square of the scale. Strings wider than the buffer are sent in chunks of
+/// whole characters, one window per chunk. The caller holds CS.
+static void _tft_write_string_scaled(const char* str, uint16_t len, uint8_t more)
+{
+    uint8_t s       = _text_size;
+    int16_t advance = (FONT_WIDTH + 1) * s;
+
+    while (len)
+    {
+        // Chunk of whole characters fitting in a buffer row
+        uint8_t n = 0;
+        int16_t w = 0;
+        while (n < len && w + advance <= ST7735_WIDTH)
+        {
+            w += advance;
+            n++;
+        }
+        int16_t next = _cursor_x + w;
+        if (n == len && !more)
+        {
+            w -= s;  // No gap after the last character
+        }
+
+        int16_t cx = _cursor_x, cy = _cursor_y, cw = w, ch = FONT_HEIGHT * s;
+        if (_tft_clip_rect(&cx, &cy, &cw, &ch))
+        {
+            _tft_set_window_rect(cx, cy, cw, ch);
+            DATA_MODE();
+
+            int16_t top    = cy - _cursor_y;  // Visible scaled rows
+            int16_t bottom = top + ch;
+            int16_t y      = 0;
+            for (uint8_t r = 0; r < FONT_HEIGHT && y < bottom; r++, y += s)
+            {
+                int16_t y0 = y > top ? y : top;
+                int16_t y1 = y + s < bottom ? y + s : bottom;
+                if (y0 >= y1)
+                {
+                    continue;
+                }
+
+                tft_wait();  // _buffer may still be queued
+
+                uint16_t sz = 0;
+                for (uint8_t k = 0; k < n; k++)
+                {
+                    const unsigned char* start = &font[str[k] + (str[k] << 2)];
+                    for (uint8_t j = 0; j <= FONT_WIDTH; j++)
+                    {
+                        uint16_t color;
+                        if (j < FONT_WIDTH)
+                        {
+                            color = (start[j] & (0x01 << r)) ? _color : _bg_color;
+                        }
+                        else if (k + 1 < n || n < len || more)
+                        {
+                            color = _bg_color;  // Gap
+                        }
+                        else
+                        {
+                            break;
+                        }
+                        for (uint8_t t = 0; t < s; t++)
+                        {
+                            _buffer[sz++] = color >> 8;
+                            _buffer[sz++] = color;
+                        }
+                    }
+                }
+
+                SPI_send_DMA(_buffer + ((cx - _cursor_x) << 1), cw << 1, y1 - y0);
+            }
+        }
+
+        _cursor_x = next;
+        str += n;
+        len -= n;
+    }
+}
+
+/// \brief Get the Glyph of a Character
+/// \param c Character
+/// \return Glyph of the current font, 0 if the font has no such character.
+static const glyph_t* _tft_glyph(char c)
+{
+    uint8_t code = c;
+    if (code < _font->first || code > _font->last)
+    {
+        return 0;
+    }
+    return &_font->glyphs[code - _font->first];
+}
+
+/// \brief Glyph Pixel Reader
+typedef struct
+{
+    const uint8_t* bits;  // Next byte
+    uint8_t        byte;  // Pixels not read yet, MSB first
+    uint8_t        left;  // Bits left in byte
+    uint8_t        bpp;   // Bits per pixel
+} glyph_reader_t;
+
+/// \brief Start Reading a Glyph Row
+/// \param rd Reader
+/// \param g Glyph
+/// \param row Row of the glyph bitmap
+static void _tft_glyph_reader_init(glyph_reader_t* rd, const glyph_t* g, uint8_t row)
+{
+    uint8_t  bpp = _font->bpp > 1 ? _font->bpp : 1;
+    uint16_t bit = row * g->width;
+    if (bpp == 2)
+    {
+        bit <<= 1;
+    }
+    else if (bpp == 4)
+    {
+        bit <<= 2;
+    }
+
+    rd->bits = _font->bitmap + g->offset + (bit >> 3);
+    rd->byte = *rd->bits++ << (bit & 7);
+    rd->left = 8 - (bit & 7);
+    rd->bpp  = bpp;
+}
+
+/// \brief Read the Next Glyph Pixel
+/// \param rd Reader
+/// \return Coverage level, 0 to TEXT_LEVELS - 1.
+static uint8_t _tft_glyph_pixel(glyph_reader_t* rd)
+{
+    if (!rd->left)
+    {
+        rd->byte = *rd->bits++;
+        rd->left = 8;
+    }
+    uint8_t level = rd->byte >> (8 - rd->bpp);
+    rd->byte <<= rd->bpp;
+    rd->left -= rd->bpp;
+
+    // Expand to 4 bits by bit replication, 1 -> 15 and 2 -> 0b1010
+    for (uint8_t b = rd->bpp; b < 4; b <<= 1)
+    {
+        level |= level << b;
+    }
+    return level;
+}
+
+/// \brief Write a Glyph Row
+/// \param str Characters of the line
+/// \param n Number of characters
+/// \param r Font row, from the top of the line
+/// \param row Destination, `w` pixels
+/// \param w Width of the line
+/// \details The row is filled with the background color, then the covered
+/// pixels of every glyph crossing it are written from the blend table, each
+/// `_text_size` pixels wide. Pixels outside the line are dropped.
+static void _tft_write_glyph_row(const char* str, uint8_t n, uint8_t r, uint8_t* row, int16_t w)
+{
+    uint8_t s = _text_size;
+
+    for (int16_t i = 0; i < w; i++)
+    {
+        row[i << 1]       = _bg_color >> 8;
+        row[(i << 1) + 1] = _bg_color;
+    }
+
+    int16_t cell = 0;
+    for (uint8_t k = 0; k < n; k++)
+    {
+        const glyph_t* g = _tft_glyph(str[k]);
+        if (!g)
+        {
+            continue;
+        }
+
+        int8_t gr = r - g->y_offset;
+        if (gr >= 0 && gr < g->height)
+        {
+            glyph_reader_t rd;
+            int16_t        x = cell + g->x_offset * s;
+            _tft_glyph_reader_init(&rd, g, gr);
+            for (uint8_t j = 0; j < g->width; j++, x += s)
+            {
+                uint8_t level = _tft_glyph_pixel(&rd);
+                if (!level)
+                {
+                    continue;
+                }
+                uint16_t color = _text_lut[level];
+                for (uint8_t t = 0; t < s; t++)
+                {
+                    if (x + t >= 0 && x + t < w)
+                    {
+                        row[(x + t) << 1]       = color >> 8;
+                        row[((x + t) << 1) + 1] = color;
+                    }
+                }
+            }
+        }
+        cell += g->advance * s;
+    }
+}
+
+/// \brief Write a String in the Proportional Font at the Cursor
+/// \param str Characters to write
+/// \param len Number of characters
+/// \details With a background, glyph rows are composed in the DMA buffer and
+/// the line is sent through one window, in bands of rows at 1x or one row
+/// repeated by DMA when scaled. Strings wider than the buffer are sent in
+/// chunks of whole characters. Transparent glyphs are written as horizontal
+/// runs of set pixels, anti-aliased pixels of at least half coverage are
+/// drawn in the text color. The caller holds CS.
+static void _tft_write_string_font(const char* str, uint16_t len)
+{
+    uint8_t s = _text_size;
+
+    _tft_text_lut();  // The colors may not have been set yet
+
+    if (_transparent)
+    {
+        for (; len; str++, len--)
+        {
+            const glyph_t* g = _tft_glyph(*str);
+            if (!g)
+            {
+                continue;
+            }
+
+            int16_t y = _cursor_y + g->y_offset * s;
+            for (uint8_t i = 0; i < g->height; i++, y += s)
+            {
+                glyph_reader_t rd;
+                int16_t        x      = _cursor_x + g->x_offset * s;
+                int16_t        run    = 0;  // Start of the run of set pixels
+                uint8_t        in_run = 0;
+                _tft_glyph_reader_init(&rd, g, i);
+                for (uint8_t j = 0; j <= g->width; j++, x += s)
+                {
+                    uint8_t set = 0;
+                    if (j < g->width)
+                    {
+                        set = _tft_glyph_pixel(&rd) >= TEXT_LEVELS / 2;  // No background to blend with
+                    }
+                    if (set && !in_run)
+                    {
+                        run    = x;
+                        in_run = 1;
+                    }
+                    else if (!set && in_run)
+                    {
+                        _tft_write_fill_rect(run, y, x - run, s, _color);
+                        in_run = 0;
+                    }
+                }
+            }
+            _cursor_x += g->advance * s;
+        }
+        return;
+    }
+
+    int16_t h = _font->height * s;
+    while (len)
+    {
+        // Chunk of whole characters fitting in a buffer row
+        uint8_t n       = 0;
+        int16_t w       = 0;
+        int16_t advance = 0;
+        while (n < len)
+        {
+            const glyph_t* g = _tft_glyph(str[n]);
+            advance          = g ? g->advance * s : 0;
+            if (w + advance > ST7735_WIDTH)
+            {
+                break;
+            }
+            w += advance;
+            n++;
+        }
+        int16_t next = _cursor_x + w;
+        if (!n)
+        {
+            // Wider than the buffer, cut to the buffer
+            n    = 1;
+            w    = ST7735_WIDTH;
+            next = _cursor_x + advance;
+        }
+
+        // Rows per band, scaled rows are repeated instead
+        uint8_t  rows = 1;
+        uint16_t size = w;  // Pixels per band
+        while (s == 1 && rows < _font->height && size + w <= ST7735_WIDTH)
+        {
+            size += w;
+            rows++;
+        }
+
+        int16_t cx = _cursor_x, cy = _cursor_y, cw = w, ch = h;
+        if (w && _tft_clip_rect(&cx, &cy, &cw, &ch))
+        {
+            _tft_set_window_rect(cx, cy, cw, ch);
+            DATA_MODE();
+
+            int16_t top    = cy - _cursor_y;  // Visible scaled rows
+            int16_t bottom = top + ch;
+            int16_t y      = 0;
+            for (uint8_t r = 0; r < _font->height && y < bottom; r += rows, y += rows * s)
+            {
+                int16_t y0 = y > top ? y : top;
+                int16_t y1 = y + rows * s < bottom ? y + rows * s : bottom;
+                if (y0 >= y1)
+                {
+                    continue;
+                }
+
+                tft_wait();  // _buffer may still be queued
+
+                uint8_t* row   = _buffer;
+                uint8_t  first = s == 1 ? r + (y0 - y) : r;
+                uint8_t  band  = s == 1 ? y1 - y0 : 1;
+                for (uint8_t i = 0; i < band; i++)
+                {
+                    _tft_write_glyph_row(str, n, first + i, row, w);
+                    row += w << 1;
+                }
+
+                row = _buffer + ((cx - _cursor_x) << 1);
+                if (s > 1)
+                {
+                    SPI_send_DMA(row, cw << 1, y1 - y0);
+                }
+                else if (cw == w)
+                {
+                    // Visible rows are contiguous
+                    SPI_send_DMA(_buffer, (w * band) << 1, 1);
+                }
+                else
+                {
+                    for (uint8_t i = 0; i < band; i++)
+                    {
+                        SPI_send_DMA(row, cw << 1, 1);
+                        row += w << 1;
+                    }
+                }
+            }
+        }
+
+        _cursor_x = next;
+        str += n;
+        len -= n;
+    }
+}
+
+/// \brief Write a String at the Cursor
+/// \param str Characters to write
+/// \param len Number of characters
+/// \param more 1 - More characters follow on the line, the gap after the last
+/// character is written.
+/// \details At 1x with a background, the text line is composed in the DMA buffer
+/// with the gaps between characters, as many rows as fit per band, and sent
+/// through one window. Strings wider than the buffer are sent in chunks of
+/// whole characters. Transparent text is written character by character.
+/// The caller holds CS.
+static void _tft_write_string(const char* str, uint16_t len, uint8_t more)
+{
+    if (_font)
+    {
+        _tft_write_string_font(str, len);
+        return;
+    }
+
+    if (_transparent)
+    {
+        int16_t advance = (FONT_WIDTH + 1) * _text_size;
+        while (len--)
+        {
+            _tft_write_char(*str++);
+            _cursor_x += advance;
+        }
+        return;
+    }
+
+    if (_text_size > 1)
+    {
+        _tft_write_string_scaled(str, len, more);
+        return;
+    }
+
+    while (len)
+    {
+        // Chunk of whole characters fitting in a buffer row
+        uint8_t n = 0;
+        int16_t w = 0;
+        while (n < len && w + FONT_WIDTH + 1 <= ST7735_WIDTH)
+        {
+            w += FONT_WIDTH + 1;
+            n++;
+        }
+        if (n == len && !more)
+        {
+            w--;  // No gap after the last character
+        }
+
+        // Rows per band
+        uint8_t  rows = 0;
+        uint16_t size = 0;  // Pixels per band
+        while (rows < FONT_HEIGHT && size + w <= ST7735_WIDTH)
+        {
+            size += w;
+            rows++;
+        }
+
+        int16_t cx = _cursor_x, cy = _cursor_y, cw = w, ch = FONT_HEIGHT;
+        if (_tft_clip_rect(&cx, &cy, &cw, &ch))
+        {
+            _tft_set_window_rect(cx, cy, cw, ch);
+            DATA_MODE();
+
+            uint8_t i   = cy - _cursor_y;  // First visible row
+            uint8_t end = i + ch;
+            while (i < end)
+            {
+                uint8_t band = end - i < rows ? end - i : rows;
+
+                tft_wait();  // _buffer may still be queued
+
+                uint16_t sz = 0;
+                for (uint8_t r = i; r < i + band; r++)
+                {
+                    for (uint8_t k = 0; k < n; k++)
+                    {
+                        const unsigned char* start = &font[str[k] + (str[k] << 2)];
+                        for (uint8_t j = 0; j < FONT_WIDTH; j++)
+                        {
+                            uint16_t color = (start[j] & (0x01 << r)) ? _color : _bg_color;
+                            _buffer[sz++]  = color >> 8;
+                            _buffer[sz++]  = color;
+                        }
+                        if (k + 1 < n || n < len || more)
+                        {
+                            _buffer[sz++] = _bg_color >> 8;
+                            _buffer[sz++] = _bg_color;
+                        }
+                    }
+                }
+
+                if (cw == w)
+                {
+                    // Visible rows are contiguous
+                    SPI_send_DMA(_buffer, sz, 1);
+                }
+                else
+                {
+                    const uint8_t* row = _buffer + ((cx - _cursor_x) << 1);
+                    for (uint8_t r = 0; r < band; r++)
+                    {
+                        SPI_send_DMA(row, cw << 1, 1);
+                        row += w << 1;
+                    }
+                }
+                i += band;
+            }
+        }
+
+        _cursor_x += n * (FONT_WIDTH + 1);
+        str += n;
+        len -= n;
+    }
+}
+
+/// \brief Get the Length of a String
+/// \param str String
+/// \return Number of characters
+static uint16_t _tft_strlen(const char* str)
+{
+    uint16_t len = 0;
+    while (str[len])
+    {
+        len++;
+    }
+    return len;
+}
+
+/// \brief Print a Character
+/// \param c Character to print
+/// \details DMA accelerated, the cursor is not moved.
+void tft_print_char(char c)
+{
+    int16_t x = _cursor_x;
+
+    START_WRITE();
+    _tft_write_string(&c, 1, 0);
+    END_WRITE();
+    _cursor_x = x;
+}
+
+/// \brief Print a String
+/// \param str String to print
+/// \details The gaps between characters are drawn with the background color.
+/// One window for each screen width of text, DMA accelerated.
+void tft_print(const char* str)
+{
+    START_WRITE();
+    _tft_write_string(str, _tft_strlen(str), 0);
+    END_WRITE();
+}
+
+/// \brief Get the Width of a String
+/// \param str Characters
+/// \param len Number of characters
+/// \return Distance the cursor moves when the string is printed.
+static int16_t _tft_string_width(const char* str, uint16_t len)
+{
+    int16_t w = 0;
+    for (; len; str++, len--)
+    {
+        if (!_font)
+        {
+            w += FONT_WIDTH + 1;
+        }
+        else if (_tft_glyph(*str))
+        {
+            w += _tft_glyph(*str)->advance;
+        }
+    }
+    return w * _text_size;
+}
+
+/// \brief Get the Size of a String
+/// \param str String
+/// \param width Width of the printed text
+/// \param height Height of the text line
+void tft_text_extent(const char* str, uint16_t* width, uint16_t* height)
+{
+    int16_t w = _tft_string_width(str, _tft_strlen(str));
+    if (!_font && w)
+    {
+        w -= _text_size;  // No gap after the last character
+    }
+    *width  = w;
+    *height = (_font ? _font->height : FONT_HEIGHT) * _text_size;
+}
+
+/// \brief Find the Next Line of Wrapped Text
+/// \param str Text, moved to the start of the following line.
+/// \param w Width of the box
+/// \param len Number of characters of the line
+/// \return Width of the line
+/// \details Lines break after the last word that fits, at spaces and '\n'.
+/// The spaces after that word are not part of the line and the spaces before
+/// the next line are skipped, spaces after '\n' are kept. A first word wider
+/// than the box is cut to the characters that fit, at least one.
+static int16_t _tft_wrap_line(const char** str, int16_t w, uint16_t* len)
+{
+    const char* s     = *str;
+    int16_t     trail = _font ? 0 : _text_size;  // Gap after the last 5x7 character
+    int16_t     adv   = 0;
+    int16_t     lw    = 0;
+    uint16_t    i     = 0;
+
+    *len = 0;
+    for (;; i++)
+    {
+        int16_t tw = i ? adv - trail : 0;  // Width of the first i characters
+        char    c  = s[i];
+        if (c == '\0' || c == '\n' || c == ' ')
+        {
+            if (!i || s[i - 1] != ' ')  // End of a word
+            {
+                if (tw > w)
+                {
+                    break;  // The last word does not fit
+                }
+                *len = i;
+                lw   = tw;
+            }
+            if (c != ' ')
+            {
+                break;
+            }
+        }
+
+        adv += _tft_string_width(&s[i], 1);
+        if (!*len && adv - trail > w)
+        {
+            // The first word is wider than the box
+            *len = i ? i : 1;
+            lw   = i ? tw : adv - trail;
+            s += *len;
+            *str = s;
+            return lw;
+        }
+    }
+
+    s += *len;
+    while (*s == ' ')
+    {
+        s++;
+    }
+    if (*s == '\n')
+    {
+        s++;
+    }
+    *str = s;
+    return lw;
+}
+
+/// \brief Print Text in a Box
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param h Height
+/// \param str Text, wrapped at spaces and '\n'.
+/// \param align Horizontal TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER or
+/// TEXT_ALIGN_RIGHT, or-ed with vertical TEXT_ALIGN_TOP, TEXT_ALIGN_MIDDLE or
+/// TEXT_ALIGN_BOTTOM.
+/// \details Lines that do not fit in the box are not drawn, a character
+/// wider than the box starts at its left and runs past its right. With a
+/// background, the rest of the box is filled in the same transaction, so a
+/// label is redrawn in one pass without overdraw. The cursor is not moved.
+void tft_print_box(int16_t x, int16_t y, uint16_t w, uint16_t h, const char* str, uint8_t align)
+{
+    int16_t  glyph_h = (_font ? _font->height : FONT_HEIGHT) * _text_size;
+    int16_t  line_h  = glyph_h + (_font ? 0 : _text_size);  // 5x7 lines are 1 row apart
+    int16_t  text_h  = 0;
+    int16_t  cursor_x = _cursor_x, cursor_y = _cursor_y;
+    uint16_t len;
+
+    // Height of the lines that fit
+    for (const char* s = str; *s && text_h + glyph_h <= (int16_t)h;)
+    {
+        _tft_wrap_line(&s, w, &len);
+        text_h += line_h;
+    }
+    if (text_h)
+    {
+        text_h -= line_h - glyph_h;
+    }
+
+    int16_t ty = y;
+    if (align & TEXT_ALIGN_MIDDLE)
+    {
+        ty += (h - text_h) >> 1;
+    }
+    else if (align & TEXT_ALIGN_BOTTOM)
+    {
+        ty += h - text_h;
+    }
+
+    int16_t end = ty + text_h;
+
+    START_WRITE();
+    if (!_transparent)
+    {
+        _tft_write_fill_rect(x, y, w, ty - y, _bg_color);
+    }
+    for (; ty < end; ty += line_h)
+    {
+        const char* line = str;
+        int16_t     lw   = _tft_wrap_line(&str, w, &len);
+        int16_t     lx   = x;
+        int16_t     room = (lw < (int16_t)w) ? w - lw : 0;  // 0 - A character wider than the box
+        if (align & TEXT_ALIGN_CENTER)
+        {
+            lx += room >> 1;
+        }
+        else if (align & TEXT_ALIGN_RIGHT)
+        {
+            lx += room;
+        }
+
+        if (!_transparent)
+        {
+            _tft_write_fill_rect(x, ty, lx - x, glyph_h, _bg_color);
+            _tft_write_fill_rect(lx + lw, ty, x + w - lx - lw, glyph_h, _bg_color);
+            if (ty + glyph_h < end)
+            {
+                _tft_write_fill_rect(x, ty + glyph_h, w, line_h - glyph_h, _bg_color);
+            }
+        }
+        _cursor_x = lx;
+        _cursor_y = ty;
+        _tft_write_string(line, len, 0);
+    }
+    if (!_transparent)
+    {
+        _tft_write_fill_rect(x, end, w, y + h - end, _bg_color);
+    }
+    END_WRITE();
+
+    _cursor_x = cursor_x;
+    _cursor_y = cursor_y;
+}
+
+// Powers of ten of 32-bit decimals, digits are found by subtraction.
+static const uint32_t _pow10[10] = {1000000000, 100000000, 10000000, 1000000, 100000,
+                                    10000,      1000,      100,      10,      1};
+
+/// \brief Format an Unsigned Decimal
+/// \param str Destination, at least 12 bytes
+/// \param value Number
+/// \param digits Minimum number of digits, padded with zeros.
+/// \param point Number of digits after the decimal point, 0 - No point.
+/// \details Each digit is counted by subtracting its power of ten, at most 9
+/// times, no software division is called.
+static void _tft_format_decimal(char* str, uint32_t value, uint8_t digits, uint8_t point)
+{
+    uint8_t started = 0;
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        uint8_t remaining = 10 - i;  // Digits left, including this one.
+        char    d         = '0';
+        while (value >= _pow10[i])
+        {
+            value -= _pow10[i];
+            d++;
+        }
+
+        if (remaining == point)
+        {
+            if (!started)
+            {
+                *str++ = '0';  // Integer part
+            }
+            *str++  = '.';
+            started = 1;
+        }
+
+        if (started || d != '0' || remaining <= digits || remaining == 1)
+        {
+            *str++  = d;
+            started = 1;
+        }
+    }
+    *str = '\0';
+}
+
+/// \brief Format a Signed Decimal
+/// \param str Destination, at least 13 bytes
+/// \param num Number
+/// \param digits Minimum number of digits, padded with zeros.
+/// \param point Number of digits after the decimal point, 0 - No point.
+static void _tft_format_signed(char* str, int32_t num, uint8_t digits, uint8_t point)
+{
+    uint32_t value = num;
+
+    if (num < 0)
+    {
+        *str++ = '-';
+        value  = -value;
+    }
+    _tft_format_decimal(str, value, digits, point);
+}
+
+/// \brief Format a Hexadecimal
+/// \param str Destination, at least 9 bytes
+/// \param num Number
+/// \param digits Minimum number of digits, padded with zeros.
+/// \param a Digit of ten, 'A' for upper case or 'a' for lower case.
+static void _tft_format_hex(char* str, uint32_t num, uint8_t digits, char a)
+{
+    uint8_t len = 0;
+
+    for (int8_t shift = 28; shift >= 0; shift -= 4)
+    {
+        uint8_t d = (num >> shift) & 0x0F;
+        if (len || d || shift < (digits << 2) || !shift)
+        {
+            str[len++] = d < 10 ? '0' + d : a - 10 + d;
+        }
+    }
+    str[len] = '\0';
+}
+
+/// \brief Print a Formatted Number Aligned in a Width
+/// \param str Formatted number
+/// \param width Expected width of the number.
+static void _tft_print_aligned(const char* str, uint16_t width)
+{
+    uint16_t num_width = _tft_string_width(str, _tft_strlen(str));
+    if (!_font)
+    {
+        num_width -= _text_size;  // No gap after the last character
+    }
+    if (width > num_width)
+    {
+        _cursor_x += width - num_width;
+    }
+
+    tft_print(str);
+}
+
+/// \brief Print an Integer
+/// \param num Number to print
+/// \param width Expected width of the number.
+/// Align left if it is less than the width of the number.
+/// Align right if it is greater than the width of the number.
+/// \details Division free.
+void tft_print_number(int32_t num, uint16_t width)
+{
+    char str[13];
+
+    _tft_format_signed(str, num, 1, 0);
+    _tft_print_aligned(str, width);
+}
+
+/// \brief Print an Integer Padded with Zeros
+/// \param num Number to print
+/// \param digits Minimum number of digits, up to 10.
+/// \details Division free.
+void tft_print_number_padded(int32_t num, uint8_t digits)
+{
+    char str[13];
+
+    _tft_format_signed(str, num, digits, 0);
+    tft_print(str);
+}
+
+/// \brief Print a Fixed-Point Number
+/// \param value Number to print, scaled by 10 to the power of `frac_digits`.
+/// \param frac_digits Number of digits after the decimal point, up to 9.
+/// \details For example, 2345 with 2 fraction digits prints 23.45. Division
+/// free.
+void tft_print_fixed(int32_t value, uint8_t frac_digits)
+{
+    char str[13];
+
+    if (frac_digits > 9)
+    {
+        frac_digits = 9;
+    }
+    _tft_format_signed(str, value, 1, frac_digits);
+    tft_print(str);
+}
+
+/// \brief Print a Hexadecimal Number
+/// \param num Number to print
+/// \param digits Minimum number of digits, padded with zeros, up to 8.
+/// \details Upper case, without prefix.
+void tft_print_hex(uint32_t num, uint8_t digits)
+{
+    char str[9];
+
+    _tft_format_hex(str, num, digits, 'A');
+    tft_print(str);
+}
+
+/// \brief Buffer a Character of tft_printf()
+/// \param chunk Characters not drawn yet
+/// \param len Number of characters in the chunk
+/// \param c Character
+/// \details A full chunk is drawn at the cursor once the next character
+/// comes, with the gap after its last character. The caller holds CS.
+static void _tft_printf_put(char* chunk, uint8_t* len, char c)
+{
+    if (*len == PRINTF_CHUNK)
+    {
+        _tft_write_string(chunk, PRINTF_CHUNK, 1);
+        *len = 0;
+    }
+    chunk[(*len)++] = c;
+}
+
+/// \brief Print Formatted Text
+/// \param format Format string, supports %d, %u, %x, %X, %s, %c and %%, with
+/// an optional `-` (align left) or `0` (pad numbers with zeros) flag and a
+/// width. An unsupported specification is printed as it is.
+/// \details No printf from the C library is linked. Characters are drawn in
+/// chunks of PRINTF_CHUNK as they are produced, in one transaction.
+void tft_printf(const char* format, ...)
+{
+    va_list args;
+    char    chunk[PRINTF_CHUNK];
+    char    number[13];
+    uint8_t len = 0;
+
+    va_start(args, format);
+    START_WRITE();
+    while (*format)
+    {
+        char c = *format++;
+        if (c != '%')
+        {
+            _tft_printf_put(chunk, &len, c);
+            continue;
+        }
+
+        const char* spec = format;
+        uint8_t     left = 0, zero = 0;
+        uint16_t    width = 0;
+        if (*format == '-')
+        {
+            left = 1;
+            format++;
+        }
+        if (*format == '0')
+        {
+            zero = 1;
+            format++;
+        }
+        while (*format >= '0' && *format <= '9')
+        {
+            width = width * 10 + (*format++ - '0');
+        }
+
+        const char* arg = number;
+        switch (*format)
+        {
+            case 'd':
+                _tft_format_signed(number, va_arg(args, int32_t), 1, 0);
+                break;
+            case 'u':
+                _tft_format_decimal(number, va_arg(args, uint32_t), 1, 0);
+                break;
+            case 'x':
+            case 'X':
+                _tft_format_hex(number, va_arg(args, uint32_t), 1, *format == 'x' ? 'a' : 'A');
+                break;
+            case 's':
+                arg  = va_arg(args, const char*);
+                zero = 0;
+                break;
+            case 'c':
+                number[0] = va_arg(args, int);
+                number[1] = '\0';
+                zero      = 0;
+                break;
+            case '%':
+                arg  = "%";
+                zero = 0;
+                break;
+            default:
+                // Unsupported, print the '%' and go on from the character
+                // after it, the specification is printed as text.
+                format = spec - 1;
+                arg    = "%";
+                left = zero = width = 0;
+                break;
+        }
+        format++;
+
+        uint16_t n = _tft_strlen(arg);
+        if (zero && !left && *arg == '-')
+        {
+            _tft_printf_put(chunk, &len, *arg++);  // The sign goes before the zeros
+        }
+        for (; !left && n < width; n++)
+        {
+            _tft_printf_put(chunk, &len, zero ? '0' : ' ');
+        }
+        while (*arg)
+        {
+            _tft_printf_put(chunk, &len, *arg++);
+        }
+        for (; left && n < width; n++)
+        {
+            _tft_printf_put(chunk, &len, ' ');
+        }
+    }
+
+    _tft_write_string(chunk, len, 0);
+    END_WRITE();
+    va_end(args);
+}
+
+#ifdef ST7735_VERTICAL
+/// \brief Set the Console Scroll Position
+/// \details The caller holds CS.
+static void _tft_console_scroll(void)
+{
+    uint16_t ssa     = ST7735_Y_OFFSET + _console_scroll;
+    uint8_t  data[2] = {ssa >> 8, ssa};
+    write_command(ST7735_VSCSAD, data, sizeof(data));
+}
+#endif
+
+/// \brief Get the Memory Row of a Console Line
+/// \param line Line, from the top of the screen
+/// \return Y coordinate to draw the line at
+static int16_t _tft_console_y(uint8_t line)
+{
+    int16_t y = _console_scroll + line * _console_line_h;
+    if (y >= _console_height)
+    {
+        y -= _console_height;
+    }
+    return y;
+}
+
+/// \brief Move the Console Cursor to the Next Line
+/// \details At the bottom, the screen is scrolled up one line and only the
+/// exposed line is cleared. Once wrapped to the top line, every new line is
+/// cleared. The caller holds CS.
+static void _tft_console_newline(void)
+{
+    _console_x = 0;
+    if (_console_line + 1 < _console_lines)
+    {
+        _console_line++;
+        if (!_console_wrapped)
+        {
+            return;  // Still clear from tft_console_begin()
+        }
+    }
+    else
+    {
+#ifdef ST7735_VERTICAL
+        // The top line becomes the bottom line
+        _console_scroll += _console_line_h;
+        if (_console_scroll >= _console_height)
+        {
+            _console_scroll -= _console_height;
+        }
+        _tft_console_scroll();
+#else
+        _console_line    = 0;  // The panel scrolls along X in this orientation, wrap
+        _console_wrapped = 1;
+#endif
+    }
+    _tft_write_fill_rect(0, _tft_console_y(_console_line), ST7735_WIDTH, _console_line_h, _bg_color);
+}
+
+/// \brief Write Characters to the Console
+/// \param str Characters
+/// \param len Number of characters
+/// \details Runs of characters fitting on the line are drawn through one
+/// window, lines wrap at the right edge. The caller holds CS.
+static void _tft_console_write(const char* str, uint16_t len)
+{
+    int16_t cursor_x = _cursor_x, cursor_y = _cursor_y;
+    int16_t trail    = _font ? 0 : _text_size;  // Gap after the last 5x7 character
+
+    while (_console_lines && len)
+    {
+        if (*str == '\n' || *str == '\r')
+        {
+            if (*str == '\n')
+            {
+                _tft_console_newline();
+            }
+            _console_x = 0;
+            str++;
+            len--;
+            continue;
+        }
+
+        uint16_t n = 0;
+        int16_t  x = _console_x;
+        while (n < len && str[n] != '\n' && str[n] != '\r')
+        {
+            int16_t advance = _tft_string_width(&str[n], 1);
+            if (x + advance - trail > ST7735_WIDTH)
+            {
+                break;
+            }
+            x += advance;
+            n++;
+        }
+        if (!n)
+        {
+            if (_console_x)
+            {
+                _tft_console_newline();
+                continue;
+            }
+            n = 1;  // Wider than the screen
+        }
+
+        _cursor_x = _console_x;
+        _cursor_y = _tft_console_y(_console_line);
+        _tft_write_string(str, n, 0);
+        _console_x = _cursor_x;
+        str += n;
+        len -= n;
+    }
+
+    _cursor_x = cursor_x;
+    _cursor_y = cursor_y;
+}
+
+/// \brief Start a Text Console
+/// \details The screen is cleared with the background color, text is printed
+/// with the current font, size and colors from the top left corner. On a
+/// vertical screen (ST7735_VERTICAL) the scroll axis of the panel is the
+/// screen Y axis and the console scrolls in hardware. On a horizontal screen
+/// the panel can only scroll along X, the console wraps to the top line
+/// instead. While scrolled, other drawing functions address memory rows,
+/// which are shifted on the screen.
+void tft_console_begin(void)
+{
+    _console_line_h = (_font ? _font->height : FONT_HEIGHT + 1) * _text_size;
+    _console_lines  = 0;
+    _console_height = 0;
+    while (_console_height + _console_line_h <= ST7735_HEIGHT)
+    {
+        _console_height += _console_line_h;
+        _console_lines++;
+    }
+    if (!_console_lines)
+    {
+        _console_height = ST7735_HEIGHT;  // Taller than the screen
+        _console_lines  = 1;
+    }
+    _console_line   = 0;
+    _console_x      = 0;
+    _console_scroll  = 0;
+    _console_wrapped = 0;
+
+    START_WRITE();
+    _tft_write_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, _bg_color);
+#ifdef ST7735_VERTICAL
+    // Scroll the whole lines, the rows below them and the unused memory rows
+    // are fixed.
+    uint16_t tfa     = ST7735_Y_OFFSET;
+    uint16_t bfa     = ST7735_GRAM_ROWS - tfa - _console_height;
+    uint8_t  data[6] = {tfa >> 8, tfa, _console_height >> 8, _console_height, bfa >> 8, bfa};
+    write_command(ST7735_VSCRDEF, data, sizeof(data));
+    _tft_console_scroll();
+#endif
+    END_WRITE();
+}
+
+/// \brief Stop the Text Console
+/// \details Back to normal display mode, memory rows are shown unscrolled.
+void tft_console_end(void)
+{
+#ifdef ST7735_VERTICAL
+    START_WRITE();
+    write_command_8(ST7735_NORON);  // Leaves the scroll mode
+    END_WRITE();
+#endif
+    _console_lines = 0;
+}
+
+/// \brief Print a Character to the Console
+/// \param c Character, '\n' starts a new line and '\r' returns to the start
+/// of the line.
+void tft_console_putc(char c)
+{
+    START_WRITE();
+    _tft_console_write(&c, 1);
+    END_WRITE();
+}
+
+/// \brief Print a String to the Console
+/// \param str String
+/// \details All characters are sent in one transaction.
+void tft_console_print(const char* str)
+{
+    START_WRITE();
+    _tft_console_write(str, _tft_strlen(str));
+    END_WRITE();
+}
+
+/// \brief Start a New Console Line
+void tft_console_newline(void)
+{
+    START_WRITE();
+    if (_console_lines)
+    {
+        _tft_console_newline();
+    }
+    END_WRITE();
+}
+
+/// \brief Draw a Pixel
+/// \param x X
+/// \param y Y
+/// \param color Pixel color
+/// \details SPI direct write
+void tft_draw_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || x >= ST7735_WIDTH || y < 0 || y >= ST7735_HEIGHT)
+    {
+        return;
+    }
+
+    x += ST7735_X_OFFSET;
+    y += ST7735_Y_OFFSET;
+    START_WRITE();
+    tft_set_window(x, y, x, y);
+    write_data_16(color);
+    END_WRITE();
+}
+
+/// \brief Fill a Rectangle Area
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param color Fill Color
+/// \details Clipped, DMA accelerated.
+void tft_fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_fill_rect(x, y, width, height, color);
+    END_WRITE();
+}
+
+/// \brief Draw a Bitmap
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param bitmap Bitmap
+/// \details Clipped, only the visible part of the bitmap is sent.
+void tft_draw_bitmap(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* bitmap)
+{
+    START_WRITE();
+    _tft_write_bitmap(x, y, width, height, bitmap);
+    END_WRITE();
+}
+
+/// \brief Write a Vertical Line Fast
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param h Height
+/// \param color Line color
+/// \details Clipped, DMA accelerated, the caller holds CS.
+static void _tft_write_fast_v_line(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    _tft_write_fill_rect(x, y, 1, h, color);
+}
+
+/// \brief Write a Horizontal Line Fast
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param color Line color
+/// \details Clipped, DMA accelerated, the caller holds CS.
+static void _tft_write_fast_h_line(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    _tft_write_fill_rect(x, y, w, 1, color);
+}
+
+/// \brief Count Horizontally Adjacent Points
+/// \param points Points
+/// \param n Number of points
+/// \return Number of points in the run starting at `points`, at least 1.
+static uint16_t _tft_pixel_run(const point_t* points, uint16_t n)
+{
+    uint16_t len = 1;
+    while (len < n && points[len].y == points->y && points[len].x == points->x + len)
+    {
+        len++;
+    }
+    return len;
+}
+
+/// \brief Draw Pixels
+/// \param points Points, sort by row then column to merge more pixels.
+/// \param n Number of points
+/// \param color Pixel color
+/// \details All points are sent in one transaction. Horizontally adjacent
+/// points are merged into one window, the window cache skips CASET/RASET when
+/// consecutive points share a column or a row.
+void tft_draw_pixels(const point_t* points, uint16_t n, uint16_t color)
+{
+    START_WRITE();
+    while (n)
+    {
+        uint16_t len = _tft_pixel_run(points, n);
+        _tft_write_fast_h_line(points->x, points->y, len, color);
+        points += len;
+        n -= len;
+    }
+    END_WRITE();
+}
+
+/// \brief Draw Pixels in Different Colors
+/// \param points Points, sort by row then column to merge more pixels.
+/// \param colors Pixel colors, one for each point.
+/// \param n Number of points
+/// \details Same as tft_draw_pixels(), merged pixels keep their own colors.
+void tft_draw_pixels_colors(const point_t* points, const uint16_t* colors, uint16_t n)
+{
+    START_WRITE();
+    while (n)
+    {
+        uint16_t len = _tft_pixel_run(points, n);
+        int16_t  x = points->x, y = points->y, w = len, h = 1;
+        if (_tft_clip_rect(&x, &y, &w, &h))
+        {
+            const uint16_t* c = colors + (x - points->x);  // First visible pixel
+            _tft_set_window_rect(x, y, w, 1);
+            while (w--)
+            {
+                write_data_16(*c++);
+            }
+        }
+        points += len;
+        colors += len;
+        n -= len;
+    }
+    END_WRITE();
+}
+
+// Draw line helpers
+#define _diff(a, b) ((a > b) ? (a - b) : (b - a))
+#define _swap_int16_t(a, b) \
+    {                       \
+        int16_t t = a;      \
+        a         = b;      \
+        b         = t;      \
+    }
+
+// Cohen-Sutherland outcodes
+#define CLIP_LEFT   0x01
+#define CLIP_RIGHT  0x02
+#define CLIP_TOP    0x04
+#define CLIP_BOTTOM 0x08
+
+/// \brief Cohen-Sutherland Outcode of a Point
+/// \param x X coordinate
+/// \param y Y coordinate
+/// \return Outcode, 0 if the point is on screen.
+static uint8_t _tft_outcode(int16_t x, int16_t y)
+{
+    uint8_t code = 0;
+    if (x < 0)
+    {
+        code |= CLIP_LEFT;
+    }
+    else if (x >= ST7735_WIDTH)
+    {
+        code |= CLIP_RIGHT;
+    }
+    if (y < 0)
+    {
+        code |= CLIP_TOP;
+    }
+    else if (y >= ST7735_HEIGHT)
+    {
+        code |= CLIP_BOTTOM;
+    }
+    return code;
+}
+
+/// \brief Bresenham's line algorithm from Arduino GFX
+/// https://github.com/moononournation/Arduino_GFX/blob/master/src/Arduino_GFX.cpp
+/// \param x0 Start X coordinate
+/// \param y0 Start Y coordinate
+/// \param x1 End X coordinate
+/// \param y1 End Y coordinate
+/// \param color Line color
+/// \details Pixels on the same row (or column when steep) are merged into
+/// spans and written as fast h/v lines, the caller holds CS.
+///
+/// Lines are clipped with Cohen-Sutherland outcodes: lines entirely on one
+/// outer side are rejected, lines entirely on screen are drawn as is. Other
+/// lines skip the invisible steps by computing the Bresenham state at the
+/// first visible step, instead of moving the end points to the screen edges,
+/// so a clipped line keeps exactly the pixels of the unclipped one.
+static void _tft_write_line_bresenham(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    uint8_t code0 = _tft_outcode(x0, y0);
+    uint8_t code1 = _tft_outcode(x1, y1);
+    if (code0 & code1)
+    {
+        return;  // Both ends on the same outer side
+    }
+
+    uint8_t steep = _diff(y1, y0) > _diff(x1, x0);
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx    = x1 - x0;
+    int16_t dy    = _diff(y1, y0);
+    int16_t err   = dx >> 1;
+    int16_t step  = (y0 < y1) ? 1 : -1;
+
+    if (code0 | code1)
+    {
+        // Visible range of step k, pixel k is (x0 + k, y0 + step * n(k)),
+        // where n(k) = ceil((k * dy - err) / dx) when k * dy > err, else 0.
+        int16_t major_max = steep ? ST7735_HEIGHT - 1 : ST7735_WIDTH - 1;
+        int16_t minor_max = steep ? ST7735_WIDTH - 1 : ST7735_HEIGHT - 1;
+        int32_t k_min     = (x0 < 0) ? -x0 : 0;
+        int32_t k_max     = (x1 > major_max) ? major_max - x0 : dx;
+        int32_t n_min     = (step > 0) ? -y0 : y0 - minor_max;
+        int32_t n_max     = (step > 0) ? minor_max - y0 : y0;
+        if (n_min > 0)
+        {
+            int32_t k = ((n_min - 1) * dx + err) / dy + 1;  // First step reaching n_min
+            if (k > k_min)
+            {
+                k_min = k;
+            }
+        }
+        if (n_max < dy)
+        {
+            int32_t k = (n_max * dx + err) / dy;  // Last step before leaving n_max
+            if (k < k_max)
+            {
+                k_max = k;
+            }
+        }
+        if (k_min > k_max)
+        {
+            return;
+        }
+
+        // Bresenham state at step k_min
+        int32_t n = (k_min * dy > err) ? (k_min * dy - err + dx - 1) / dx : 0;
+        x1  = x0 + k_max;
+        x0  = x0 + k_min;
+        y0  = y0 + step * n;
+        err = err - k_min * dy + n * dx;
+    }
+
+    int16_t start = x0;  // Start of the current span
+
+    for (; x0 <= x1; x0++)
+    {
+        err -= dy;
+        if (err < 0 || x0 == x1)
+        {
+            if (steep)
+            {
+                _tft_write_fast_v_line(y0, start, x0 - start + 1, color);
+            }
+            else
+            {
+                _tft_write_fast_h_line(start, y0, x0 - start + 1, color);
+            }
+            start = x0 + 1;
+            err += dx;
+            y0 += step;
+        }
+    }
+}
+
+/// \brief Quarter Circle Profile
+/// \details Half width of a circle of radius R on the row dy from its center,
+/// the largest x with x^2 + dy^2 <= R^2 + R. Stepped from dy = R toward 0.
+typedef struct
+{
+    int16_t x;  // Half width on the current row
+    int32_t e;  // R^2 + R - dy^2 - (x + 1)^2
+} arc_t;
+
+/// \brief Start a Quarter Circle Profile at dy = R
+/// \param a Profile
+/// \param r Radius R
+static void _tft_arc_init(arc_t* a, int16_t r)
+{
+    a->x = 0;
+    a->e = r - 1;
+    while (a->e >= 0)
+    {
+        a->x++;
+        a->e -= (a->x << 1) + 1;
+    }
+}
+
+/// \brief Step a Quarter Circle Profile from dy + 1 to dy
+/// \param a Profile
+/// \param dy New row from the center
+static void _tft_arc_step(arc_t* a, int16_t dy)
+{
+    a->e += (dy << 1) + 1;
+    while (a->e >= 0)
+    {
+        a->x++;
+        a->e -= (a->x << 1) + 1;
+    }
+}
+
+/// \brief Write a Row of a Ring
+/// \param y Y coordinate
+/// \param x0 Outer start X coordinate
+/// \param x1 Outer end X coordinate
+/// \param i0 Inner start X coordinate
+/// \param i1 Inner end X coordinate, less than i0 if there is no hole.
+/// \param color Row color
+/// \details Writes the outer span minus the inner one. The caller holds CS.
+static void _tft_write_ring_row(int16_t y, int16_t x0, int16_t x1, int16_t i0, int16_t i1, uint16_t color)
+{
+    if (i0 > i1)
+    {
+        _tft_write_fast_h_line(x0, y, x1 - x0 + 1, color);
+        return;
+    }
+    if (i0 > x0)
+    {
+        _tft_write_fast_h_line(x0, y, i0 - x0, color);
+    }
+    if (x1 > i1)
+    {
+        _tft_write_fast_h_line(i1 + 1, y, x1 - i1, color);
+    }
+}
+
+/// \brief Draw a Rounded Rectangle Outline or Fill
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param w Width
+/// \param h Height
+/// \param r Corner radius, clamped to half the width and the height.
+/// \param t Outline thickness, filled if it reaches half the width or height.
+/// \param color Color
+/// \details The inner edge is the outer one inset by t, its corners share the
+/// centers of the outer ones. Corner rows are written as spans, top and
+/// bottom together, the straight parts as rectangles, all in one transaction.
+static void _tft_draw_round_rect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, int16_t t, uint16_t color)
+{
+    if (w <= 0 || h <= 0 || t <= 0)
+    {
+        return;
+    }
+    int16_t half = ((w < h) ? w : h) >> 1;
+    if (r > half)
+    {
+        r = half;
+    }
+    uint8_t filled = t > half;
+    if (filled)
+    {
+        t = h;  // No hole on any row
+    }
+
+    int16_t ri = r - t;          // Inner corner radius, square if not positive
+    int16_t cl = x + r;          // Left corner center
+    int16_t cr = x + w - 1 - r;  // Right corner center
+    arc_t   outer, inner = {0};  // The inner profile is only used with a hole
+
+    START_WRITE();
+    _tft_arc_init(&outer, r);
+    if (ri > 0)
+    {
+        _tft_arc_init(&inner, ri);
+    }
+    for (int16_t j = 0; j < r; j++)
+    {
+        int16_t dy = r - j;
+        if (j)
+        {
+            _tft_arc_step(&outer, dy);
+        }
+        int16_t i0 = 1, i1 = 0;  // No hole
+        if (j >= t)
+        {
+            if (ri > 0)
+            {
+                if (j > t)
+                {
+                    _tft_arc_step(&inner, dy);
+                }
+                i0 = cl - inner.x;
+                i1 = cr + inner.x;
+            }
+            else
+            {
+                i0 = x + t;
+                i1 = x + w - 1 - t;
+            }
+        }
+        _tft_write_ring_row(y + j, cl - outer.x, cr + outer.x, i0, i1, color);
+        _tft_write_ring_row(y + h - 1 - j, cl - outer.x, cr + outer.x, i0, i1, color);
+    }
+
+    // Straight part, full rows down to the thickness then the two sides
+    if (filled)
+    {
+        _tft_write_fill_rect(x, y + r, w, h - (r << 1), color);
+        END_WRITE();
+        return;
+    }
+    int16_t m = (t > r) ? t : r;
+    if (m > r)
+    {
+        _tft_write_fill_rect(x, y + r, w, m - r, color);
+        _tft_write_fill_rect(x, y + h - m, w, m - r, color);
+    }
+    if (h - (m << 1) > 0)
+    {
+        _tft_write_fill_rect(x, y + m, t, h - (m << 1), color);
+        _tft_write_fill_rect(x + w - t, y + m, t, h - (m << 1), color);
+    }
+    END_WRITE();
+}
+
+/// \brief Draw a Rectangle
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
 /// \param color Line color
-/// \details DMA accelerated
-static void _tft_draw_fast_h_line(int16_t x, int16_t y, int16_t w, uint16_t color)
+void tft_draw_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
 {
-    x += ST7735_X_OFFSET;
-    y += ST7735_Y_OFFSET;
+    _tft_draw_round_rect(x, y, width, height, 0, 1, color);
+}
+
+/// \brief Draw a Rounded Rectangle
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param radius Corner radius
+/// \param thickness Outline thickness
+/// \param color Line color
+void tft_draw_round_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t radius, uint16_t thickness, uint16_t color)
+{
+    _tft_draw_round_rect(x, y, width, height, radius, thickness, color);
+}
+
+/// \brief Fill a Rounded Rectangle
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param radius Corner radius
+/// \param color Fill color
+void tft_fill_round_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t radius, uint16_t color)
+{
+    _tft_draw_round_rect(x, y, width, height, radius, height, color);
+}
+
+/// \brief Write Line Function from Arduino GFX
+/// https://github.com/moononournation/Arduino_GFX/blob/master/src/Arduino_GFX.cpp
+/// \param x0 Start X coordinate
+/// \param y0 Start Y coordinate
+/// \param x1 End X coordinate
+/// \param y1 End Y coordinate
+/// \param color Line color
+/// \details The caller holds CS.
+static void _tft_write_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+        {
+            _swap_int16_t(y0, y1);
+        }
+        _tft_write_fast_v_line(x0, y0, y1 - y0 + 1, color);
+    }
+    else if (y0 == y1)
+    {
+        if (x0 > x1)
+        {
+            _swap_int16_t(x0, x1);
+        }
+        _tft_write_fast_h_line(x0, y0, x1 - x0 + 1, color);
+    }
+    else
+    {
+        _tft_write_line_bresenham(x0, y0, x1, y1, color);
+    }
+}
+
+/// \brief Draw a Line
+/// \param x0 Start X coordinate
+/// \param y0 Start Y coordinate
+/// \param x1 End X coordinate
+/// \param y1 End Y coordinate
+/// \param color Line color
+void tft_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_line(x0, y0, x1, y1, color);
+    END_WRITE();
+}
+
+/// \brief Triangle Edge Walker
+/// \details Steps x by dx / dy per row without a division in the loop.
+/// x is truncated toward x0, like x0 + dx * t / dy.
+typedef struct
+{
+    int16_t x;     // Current x
+    int16_t step;  // Whole pixels per row, signed
+    int16_t rem;   // Remaining fraction numerator per row
+    int16_t dy;    // Fraction denominator
+    int16_t err;   // Fraction accumulator
+    int8_t  sign;  // Direction of dx
+} edge_t;
+
+/// \brief Start a Triangle Edge
+/// \param e Edge
+/// \param x0 Start X coordinate
+/// \param x1 End X coordinate
+/// \param dy Rows from start to end, greater than 0.
+static void _tft_edge_init(edge_t* e, int16_t x0, int16_t x1, int16_t dy)
+{
+    int16_t dx = x1 - x0;
+    e->sign    = (dx < 0) ? -1 : 1;
+    dx         = _diff(x1, x0);
+    e->x       = x0;
+    e->step    = e->sign * (dx / dy);
+    e->rem     = dx % dy;
+    e->dy      = dy;
+    e->err     = 0;
+}
+
+/// \brief Step a Triangle Edge to the Next Row
+/// \param e Edge
+static void _tft_edge_step(edge_t* e)
+{
+    e->x += e->step;
+    e->err += e->rem;
+    if (e->err >= e->dy)
+    {
+        e->err -= e->dy;
+        e->x += e->sign;
+    }
+}
+
+/// \brief Write a Span between Two Edges
+/// \param a X coordinate of one edge
+/// \param b X coordinate of the other edge
+/// \param y Y coordinate
+/// \param color Span color
+/// \details The caller holds CS.
+static void _tft_write_span(int16_t a, int16_t b, int16_t y, uint16_t color)
+{
+    if (a > b)
+    {
+        _swap_int16_t(a, b);
+    }
+    _tft_write_fast_h_line(a, y, b - a + 1, color);
+}
+
+/// \brief Fill a Triangle
+/// \param x0 First X coordinate
+/// \param y0 First Y coordinate
+/// \param x1 Second X coordinate
+/// \param y1 Second Y coordinate
+/// \param x2 Third X coordinate
+/// \param y2 Third Y coordinate
+/// \param color Fill color
+/// \details Scanline fill from Adafruit GFX, split into a flat bottom and a
+/// flat top half. Each row is one span, all rows in one transaction.
+void tft_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    // Sort by Y, y0 <= y1 <= y2
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
+    if (y1 > y2)
+    {
+        _swap_int16_t(y2, y1);
+        _swap_int16_t(x2, x1);
+    }
+    if (y0 > y1)
+    {
+        _swap_int16_t(y0, y1);
+        _swap_int16_t(x0, x1);
+    }
 
-    uint16_t sz = 0;
-    for (int16_t j = 0; j < w; j++)
+    if (y2 < 0 || y0 >= ST7735_HEIGHT)
     {
-        _buffer[sz++] = color >> 8;
-        _buffer[sz++] = color;
+        return;
     }
 
     START_WRITE();
-    tft_set_window(x, y, x + w - 1, y);
-    DATA_MODE();
-    SPI_send_DMA(_buffer, sz, 1);
+    if (y0 == y2)
+    {
+        // All on one row
+        if (x0 > x1)
+        {
+            _swap_int16_t(x0, x1);
+        }
+        if (x1 > x2)
+        {
+            _swap_int16_t(x1, x2);
+        }
+        if (x0 > x1)
+        {
+            _swap_int16_t(x0, x1);
+        }
+        _tft_write_span(x0, x2, y0, color);
+        END_WRITE();
+        return;
+    }
+
+    edge_t  a, b;
+    int16_t y    = y0;
+    int16_t last = (y1 == y2) ? y1 : y1 - 1;  // Include row y1 here if flat bottom
+    int16_t end  = (y2 < ST7735_HEIGHT) ? y2 : ST7735_HEIGHT - 1;
+
+    _tft_edge_init(&b, x0, x2, y2 - y0);
+    if (y1 > y0)
+    {
+        // Upper half, edges 0-1 and 0-2
+        _tft_edge_init(&a, x0, x1, y1 - y0);
+        for (; y <= last && y <= end; y++)
+        {
+            _tft_write_span(a.x, b.x, y, color);
+            _tft_edge_step(&a);
+            _tft_edge_step(&b);
+        }
+    }
+    if (y2 > y1)
+    {
+        // Lower half, edges 1-2 and 0-2
+        _tft_edge_init(&a, x1, x2, y2 - y1);
+        for (; y <= end; y++)
+        {
+            _tft_write_span(a.x, b.x, y, color);
+            _tft_edge_step(&a);
+            _tft_edge_step(&b);
+        }
+    }
+    END_WRITE();
+}
+
+/// \brief Draw a Triangle
+/// \param x0 First X coordinate
+/// \param y0 First Y coordinate
+/// \param x1 Second X coordinate
+/// \param y1 Second Y coordinate
+/// \param x2 Third X coordinate
+/// \param y2 Third Y coordinate
+/// \param color Line color
+void tft_draw_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_line(x0, y0, x1, y1, color);
+    _tft_write_line(x1, y1, x2, y2, color);
+    _tft_write_line(x2, y2, x0, y0, color);
     END_WRITE();
 }
 
-// Draw line helpers
-#define _diff(a, b) ((a > b) ? (a - b) : (b - a))
-#define _swap_int16_t(a, b) \
-    {                       \
-        int16_t t = a;      \
-        a         = b;      \
-        b         = t;      \
+/// \brief Write a Horizontal Run Mirrored into Four Quadrants
+/// \param x0 Center X coordinate
+/// \param y0 Center Y coordinate
+/// \param xa Run start, relative to the center
+/// \param xb Run end, relative to the center
+/// \param y Run row, relative to the center
+/// \param color Run color
+/// \details A run starting on the center column is merged with its mirror,
+/// so fills are written as one span per scanline. The caller holds CS.
+static void _tft_write_quad_h(int16_t x0, int16_t y0, int16_t xa, int16_t xb, int16_t y, uint16_t color)
+{
+    if (xa == 0)
+    {
+        _tft_write_fast_h_line(x0 - xb, y0 - y, (xb << 1) + 1, color);
+        if (y)
+        {
+            _tft_write_fast_h_line(x0 - xb, y0 + y, (xb << 1) + 1, color);
+        }
+        return;
+    }
+    _tft_write_fast_h_line(x0 - xb, y0 - y, xb - xa + 1, color);
+    _tft_write_fast_h_line(x0 + xa, y0 - y, xb - xa + 1, color);
+    if (y)
+    {
+        _tft_write_fast_h_line(x0 - xb, y0 + y, xb - xa + 1, color);
+        _tft_write_fast_h_line(x0 + xa, y0 + y, xb - xa + 1, color);
+    }
+}
+
+/// \brief Write a Vertical Run Mirrored into Four Quadrants
+/// \param x0 Center X coordinate
+/// \param y0 Center Y coordinate
+/// \param x Run column, relative to the center
+/// \param ya Run start, relative to the center
+/// \param yb Run end, relative to the center
+/// \param color Run color
+/// \details The caller holds CS.
+static void _tft_write_quad_v(int16_t x0, int16_t y0, int16_t x, int16_t ya, int16_t yb, uint16_t color)
+{
+    if (ya == 0)
+    {
+        _tft_write_fast_v_line(x0 - x, y0 - yb, (yb << 1) + 1, color);
+        _tft_write_fast_v_line(x0 + x, y0 - yb, (yb << 1) + 1, color);
+        return;
+    }
+    _tft_write_fast_v_line(x0 - x, y0 - yb, yb - ya + 1, color);
+    _tft_write_fast_v_line(x0 - x, y0 + ya, yb - ya + 1, color);
+    _tft_write_fast_v_line(x0 + x, y0 - yb, yb - ya + 1, color);
+    _tft_write_fast_v_line(x0 + x, y0 + ya, yb - ya + 1, color);
+}
+
+/// \brief Draw an Ellipse with the Midpoint Algorithm
+/// \param x0 Center X coordinate
+/// \param y0 Center Y coordinate
+/// \param rx Horizontal radius
+/// \param ry Vertical radius
+/// \param fill Fill the ellipse if non-zero, draw the outline otherwise.
+/// \param color Ellipse color
+/// \details Walks one quadrant from (0, ry) to (rx, 0) and mirrors it.
+/// Region 1 (slope above -1) yields horizontal runs, region 2 vertical runs.
+/// Outlines write each run as a span, fills write one span per pair of
+/// scanlines, all in one transaction. Only additions in the loops.
+static void _tft_draw_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint8_t fill, uint16_t color)
+{
+    int16_t bx = x0 - rx, by = y0 - ry, bw = (rx << 1) + 1, bh = (ry << 1) + 1;
+    if (!_tft_clip_rect(&bx, &by, &bw, &bh))
+    {
+        return;
+    }
+
+    START_WRITE();
+    if (rx == 0 || ry == 0)
+    {
+        _tft_write_fill_rect(x0 - rx, y0 - ry, (rx << 1) + 1, (ry << 1) + 1, color);
+        END_WRITE();
+        return;
+    }
+
+    int32_t rx2 = (int32_t)rx * rx;
+    int32_t ry2 = (int32_t)ry * ry;
+    int16_t x   = 0;
+    int16_t y   = ry;
+    int16_t xa  = 0;  // Start of the current horizontal run
+    int32_t px  = 0;  // 2 * ry^2 * x
+    int32_t py  = (rx2 << 1) * ry;  // 2 * rx^2 * y
+    int32_t p   = ry2 - rx2 * ry + (rx2 >> 2);
+
+    // Region 1: x steps every time, y sometimes
+    while (px < py)
+    {
+        x++;
+        px += ry2 << 1;
+        if (p < 0)
+        {
+            p += ry2 + px;
+        }
+        else
+        {
+            _tft_write_quad_h(x0, y0, fill ? 0 : xa, x - 1, y, color);
+            xa = x;
+            y--;
+            py -= rx2 << 1;
+            p += ry2 + px - py;
+        }
+    }
+    _tft_write_quad_h(x0, y0, fill ? 0 : xa, x, y, color);
+
+    // Region 2: y steps every time, x sometimes
+    int16_t yb = y - 1;  // Top of the current vertical run
+    p = ry2 * ((int32_t)x * x + x) + (ry2 >> 2) + rx2 * ((int32_t)(y - 1) * (y - 1) - ry2);
+    while (y > 0)
+    {
+        y--;
+        py -= rx2 << 1;
+        if (p > 0)
+        {
+            p += rx2 - py;
+        }
+        else
+        {
+            if (!fill && yb > y)
+            {
+                _tft_write_quad_v(x0, y0, x, y + 1, yb, color);
+            }
+            yb = y;
+            x++;
+            px += ry2 << 1;
+            p += rx2 - py + px;
+        }
+        if (fill)
+        {
+            _tft_write_quad_h(x0, y0, 0, x, y, color);
+        }
+    }
+    if (!fill)
+    {
+        _tft_write_quad_v(x0, y0, x, 0, yb, color);
+    }
+    END_WRITE();
+}
+
+/// \brief Draw a Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Circle color
+void tft_draw_circle(int16_t x, int16_t y, uint16_t r, uint16_t color)
+{
+    _tft_draw_ellipse(x, y, r, r, 0, color);
+}
+
+/// \brief Fill a Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Fill color
+void tft_fill_circle(int16_t x, int16_t y, uint16_t r, uint16_t color)
+{
+    _tft_draw_ellipse(x, y, r, r, 1, color);
+}
+
+/// \brief Draw an Ellipse
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param rx Horizontal radius
+/// \param ry Vertical radius
+/// \param color Ellipse color
+void tft_draw_ellipse(int16_t x, int16_t y, uint16_t rx, uint16_t ry, uint16_t color)
+{
+    _tft_draw_ellipse(x, y, rx, ry, 0, color);
+}
+
+/// \brief Fill an Ellipse
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param rx Horizontal radius
+/// \param ry Vertical radius
+/// \param color Fill color
+void tft_fill_ellipse(int16_t x, int16_t y, uint16_t rx, uint16_t ry, uint16_t color)
+{
+    _tft_draw_ellipse(x, y, rx, ry, 1, color);
+}
+
+/// \brief Active Polygon Edge
+typedef struct
+{
+    int32_t x;      // X on the current row, 16.16 fixed point
+    int32_t dx;     // X step per row, 16.16 fixed point
+    int16_t y_end;  // First row below the edge
+    int8_t  dir;    // Winding, 1 downward, -1 upward
+} poly_edge_t;
+
+/// \brief Fill a Polygon with an Active Edge Table
+/// \param points Vertices, the last one connects back to the first.
+/// \param n Number of vertices
+/// \param color Fill color
+/// \param non_zero Non-zero winding rule if non-zero, even-odd otherwise.
+/// \details Rows are sampled at integer y, an edge covers its top row but
+/// not its bottom one, and a span covers the pixels whose center is inside.
+/// A center exactly on an edge belongs to the right of it, so polygons
+/// sharing an edge do not overlap. X is stepped rounded up, always ahead of
+/// the exact edge by less than the sample spacing for edges of up to 181
+/// rows. The active edge table lives
+/// on the stack and holds POLYGON_MAX_EDGES edges. A polygon with more edges
+/// crossing one visible row is rejected before anything is drawn. Each row
+/// is written as spans, all rows in one transaction.
+static void _tft_fill_polygon(const point_t* points, uint16_t n, uint16_t color, uint8_t non_zero)
+{
+    poly_edge_t edges[POLYGON_MAX_EDGES];
+    uint8_t     active = 0;
+
+    if (n < 3)
+    {
+        return;
+    }
+
+    int16_t y_min = points[0].y;
+    int16_t y_max = points[0].y;
+    for (uint16_t i = 1; i < n; i++)
+    {
+        if (points[i].y < y_min)
+        {
+            y_min = points[i].y;
+        }
+        if (points[i].y > y_max)
+        {
+            y_max = points[i].y;
+        }
+    }
+    if (y_min < 0)
+    {
+        y_min = 0;
+    }
+    if (y_max > ST7735_HEIGHT)
+    {
+        y_max = ST7735_HEIGHT;
+    }
+
+    // Reject more edges on a visible row than the table holds, a polygon with
+    // no more vertices than that cannot have them.
+    for (int16_t y = y_min; n > POLYGON_MAX_EDGES && y < y_max; y++)
+    {
+        uint16_t       crossing = 0;
+        const point_t* p0       = &points[n - 1];
+        for (uint16_t i = 0; i < n; i++)
+        {
+            crossing += (p0->y <= y) != (points[i].y <= y);
+            p0 = &points[i];
+        }
+        if (crossing > POLYGON_MAX_EDGES)
+        {
+            return;
+        }
+    }
+
+    START_WRITE();
+    for (int16_t y = y_min; y < y_max; y++)
+    {
+        // Drop edges ending above this row
+        uint8_t k = 0;
+        for (uint8_t i = 0; i < active; i++)
+        {
+            if (edges[i].y_end > y)
+            {
+                edges[k++] = edges[i];
+            }
+        }
+        active = k;
+
+        // Add edges starting on this row, or crossing the first visible row
+        const point_t* p0 = &points[n - 1];
+        for (uint16_t i = 0; i < n; i++)
+        {
+            const point_t* p1  = &points[i];
+            const point_t* top = (p0->y < p1->y) ? p0 : p1;
+            const point_t* bot = (p0->y < p1->y) ? p1 : p0;
+            if (bot->y > y && (top->y == y || (y == y_min && top->y < y)))
+            {
+                poly_edge_t* e  = &edges[active++];
+                int32_t      dx = (int32_t)(bot->x - top->x) << 16;
+                int16_t      dy = bot->y - top->y;
+                e->dx           = (dx > 0 ? dx + dy - 1 : dx) / dy;  // Rounded up
+                e->x            = ((int32_t)top->x << 16) + 0x8000 + e->dx * (y - top->y);
+                e->y_end        = bot->y;
+                e->dir          = (p0 == top) ? 1 : -1;
+            }
+            p0 = p1;
+        }
+
+        // Insertion sort by x, the order barely changes between rows
+        for (uint8_t i = 1; i < active; i++)
+        {
+            poly_edge_t e = edges[i];
+            uint8_t     j = i;
+            for (; j > 0 && edges[j - 1].x > e.x; j--)
+            {
+                edges[j] = edges[j - 1];
+            }
+            edges[j] = e;
+        }
+
+        // Spans between the crossings inside the polygon
+        int8_t  winding = 0;
+        int16_t start   = 0;
+        for (uint8_t i = 0; i < active; i++)
+        {
+            int16_t x      = edges[i].x >> 16;
+            int8_t  inside = winding != 0;
+            winding        = non_zero ? winding + edges[i].dir : winding ^ 1;
+            if (!inside && winding)
+            {
+                start = x;
+            }
+            else if (inside && !winding && x > start)
+            {
+                _tft_write_fast_h_line(start, y, x - start, color);
+            }
+            edges[i].x += edges[i].dx;
+        }
+    }
+    END_WRITE();
+}
+
+/// \brief Fill a Polygon, Even-Odd Rule
+/// \param points Vertices, the last one connects back to the first.
+/// \param n Number of vertices
+/// \param color Fill color
+void tft_fill_polygon(const point_t* points, uint16_t n, uint16_t color)
+{
+    _tft_fill_polygon(points, n, color, 0);
+}
+
+/// \brief Fill a Polygon, Non-Zero Winding Rule
+/// \param points Vertices, the last one connects back to the first.
+/// \param n Number of vertices
+/// \param color Fill color
+void tft_fill_polygon_non_zero(const point_t* points, uint16_t n, uint16_t color)
+{
+    _tft_fill_polygon(points, n, color, 1);
+}
+
+/// \brief Build the Anti-Aliasing Blend Table
+/// \param color Foreground color, level AA_LEVELS
+/// \param bg_color Background color, level 0
+/// \details Channels are interpolated by accumulation, no multiplication.
+/// Nothing is done if the color pair is unchanged.
+static void _tft_aa_lut(uint16_t color, uint16_t bg_color)
+{
+    if (color == _aa_color && bg_color == _aa_bg_color)
+    {
+        return;
+    }
+    _aa_color    = color;
+    _aa_bg_color = bg_color;
+
+    int16_t r = bg_color >> 11, g = (bg_color >> 5) & 0x3F, b = bg_color & 0x1F;
+    int16_t dr = (color >> 11) - r, dg = ((color >> 5) & 0x3F) - g, db = (color & 0x1F) - b;
+    int16_t ar = 0, ag = 0, ab = 0;
+    for (uint8_t i = 0; i <= AA_LEVELS; i++)
+    {
+        _aa_lut[i] = ((r + (ar >> AA_SHIFT)) << 11) | ((g + (ag >> AA_SHIFT)) << 5) | (b + (ab >> AA_SHIFT));
+        ar += dr;
+        ag += dg;
+        ab += db;
+    }
+}
+
+/// \brief Blend Level of a Fraction
+/// \param num Numerator, not negative
+/// \param den Denominator, greater than 0
+/// \return num / den in AA_LEVELS steps, at most AA_LEVELS.
+/// \details Shift-and-subtract division, no multiplication.
+static uint8_t _tft_aa_level(int32_t num, int32_t den)
+{
+    uint8_t level = 0;
+    num <<= AA_SHIFT;
+    for (int8_t bit = AA_SHIFT; bit >= 0; bit--)
+    {
+        if (num >= (den << bit))
+        {
+            num -= den << bit;
+            level |= 1 << bit;
+        }
+    }
+    return (level > AA_LEVELS) ? AA_LEVELS : level;
+}
+
+/// \brief Write Blended Pixels along a Row or a Column
+/// \param x First pixel X coordinate
+/// \param y First pixel Y coordinate
+/// \param vertical Pixels go down a column if non-zero, along a row otherwise.
+/// \param dir 1 toward higher coordinates, -1 toward lower ones.
+/// \param level Blend levels, pixels at level 0 are left untouched.
+/// \param len Number of pixels
+/// \details Each run of non-zero levels is one clipped window. The caller
+/// holds CS.
+static void _tft_write_aa_span(int16_t x, int16_t y, uint8_t vertical, int8_t dir, const uint8_t* level, uint8_t len)
+{
+    uint8_t i = 0;
+    while (i < len)
+    {
+        if (!level[i])
+        {
+            i++;
+            continue;
+        }
+        uint8_t j = i;
+        while (j < len && level[j])
+        {
+            j++;
+        }
+
+        // Window of levels [i, j), from its lowest coordinate
+        int16_t lo = (dir > 0) ? i : 1 - j;
+        int16_t wx = vertical ? x : x + lo;
+        int16_t wy = vertical ? y + lo : y;
+        int16_t ww = vertical ? 1 : j - i;
+        int16_t wh = vertical ? j - i : 1;
+        int16_t ox = wx, oy = wy;
+        if (_tft_clip_rect(&wx, &wy, &ww, &wh))
+        {
+            int16_t skip = (wx - ox) + (wy - oy);  // Clipped at the low end
+            int16_t k    = (dir > 0) ? i + skip : j - 1 - skip;
+            int16_t n    = ww + wh - 1;
+            _tft_set_window_rect(wx, wy, ww, wh);
+            while (n--)
+            {
+                write_data_16(_aa_lut[level[k]]);
+                k += dir;
+            }
+        }
+        i = j;
     }
+}
 
-/// \brief Bresenham's line algorithm from Arduino GFX
-/// https://github.com/moononournation/Arduino_GFX/blob/master/src/Arduino_GFX.cpp
+/// \brief Draw an Anti-Aliased Line
 /// \param x0 Start X coordinate
 /// \param y0 Start Y coordinate
 /// \param x1 End X coordinate
 /// \param y1 End Y coordinate
 /// \param color Line color
-/// \details SPI direct write
-static void _tft_draw_line_bresenham(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+/// \param bg_color Background color to blend with, the panel can not be read.
+/// \details Xiaolin Wu's line with a 16-bit error accumulator, see Michael
+/// Abrash, Graphics Programming Black Book, chapter 42. Each step blends a
+/// pixel on the line and its neighbour toward the next minor coordinate.
+/// Steps sharing the minor coordinate are buffered and written as two
+/// windows, all in one transaction.
+void tft_draw_line_aa(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color, uint16_t bg_color)
 {
+    if (_tft_outcode(x0, y0) & _tft_outcode(x1, y1))
+    {
+        return;  // Both ends on the same outer side
+    }
+
     uint8_t steep = _diff(y1, y0) > _diff(x1, x0);
     if (steep)
     {
         _swap_int16_t(x0, y0);
         _swap_int16_t(x1, y1);
     }
-
     if (x0 > x1)
     {
         _swap_int16_t(x0, x1);
         _swap_int16_t(y0, y1);
     }
 
-    int16_t dx   = x1 - x0;
-    int16_t dy   = _diff(y1, y0);
-    int16_t err  = dx >> 1;
-    int16_t step = (y0 < y1) ? 1 : -1;
+    int16_t  dx   = x1 - x0;
+    int8_t   step = (y0 < y1) ? 1 : -1;
+    uint32_t adj  = dx ? (((uint32_t)_diff(y1, y0) << 16) + dx - 1) / dx : 0;  // Rounded up, ends on y1
+    uint32_t acc  = 0;
+    uint8_t  line[AA_RUN_MAX];  // Levels on the line
+    uint8_t  side[AA_RUN_MAX];  // Levels of the neighbours
+    uint8_t  len   = 0;
+    int16_t  start = x0;
 
-    for (; x0 <= x1; x0++)
+    _tft_aa_lut(color, bg_color);
+
+    START_WRITE();
+    for (int16_t x = x0; x <= x1; x++)
     {
-        if (steep)
+        uint8_t w = acc >> (16 - AA_SHIFT);
+        line[len] = AA_LEVELS - w;
+        side[len] = w;
+        len++;
+
+        acc += adj;
+        uint8_t carry = acc >> 16;
+        acc &= 0xFFFF;
+        if (carry || len == AA_RUN_MAX || x == x1)
         {
-            tft_draw_pixel(y0, x0, color);
+            if (steep)
+            {
+                _tft_write_aa_span(y0, start, 1, 1, line, len);
+                _tft_write_aa_span(y0 + step, start, 1, 1, side, len);
+            }
+            else
+            {
+                _tft_write_aa_span(start, y0, 0, 1, line, len);
+                _tft_write_aa_span(start, y0 + step, 0, 1, side, len);
+            }
+            start = x + 1;
+            len   = 0;
         }
-        else
+        if (carry)
         {
-            tft_draw_pixel(x0, y0, color);
+            y0 += step;
         }
-        err -= dy;
-        if (err < 0)
+    }
+    END_WRITE();
+}
+
+/// \brief Write an Anti-Aliased Circle Segment Mirrored into Eight Octants
+/// \param x0 Center X coordinate
+/// \param y0 Center Y coordinate
+/// \param xa First column of the segment, relative to the center
+/// \param y Row of the segment, relative to the center
+/// \param inner Levels on row y
+/// \param outer Levels on row y + 1
+/// \param len Number of columns
+/// \details The caller holds CS.
+static void _tft_write_aa_octants(int16_t x0, int16_t y0, int16_t xa, int16_t y, const uint8_t* inner, const uint8_t* outer, uint8_t len)
+{
+    for (int8_t sy = -1; sy <= 1; sy += 2)
+    {
+        int16_t ri = (sy > 0) ? y : -y;  // Inner row (or column) offset
+        int16_t ro = ri + sy;            // Outer row (or column) offset
+        for (int8_t sx = -1; sx <= 1; sx += 2)
         {
-            err += dx;
-            y0 += step;
+            int16_t c = (sx > 0) ? xa : -xa;
+            _tft_write_aa_span(x0 + c, y0 + ri, 0, sx, inner, len);
+            _tft_write_aa_span(x0 + c, y0 + ro, 0, sx, outer, len);
+            _tft_write_aa_span(x0 + ri, y0 + c, 1, sx, inner, len);
+            _tft_write_aa_span(x0 + ro, y0 + c, 1, sx, outer, len);
         }
     }
 }
 
-/// \brief Draw a Rectangle
-/// \param x0 Start X coordinate
-/// \param y0 Start Y coordinate
-/// \param x1 End X coordinate
-/// \param y1 End Y coordinate
-/// \param color Line color
-void tft_draw_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color)
+/// \brief Draw an Anti-Aliased Circle
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param color Circle color
+/// \param bg_color Background color to blend with, the panel can not be read.
+/// \details Xiaolin Wu's circle. For each column of the first octant, the
+/// exact row sqrt(r^2 - x^2) is split into its integer part, kept by
+/// stepping down, and its fraction, found by shift-and-subtract. Columns
+/// sharing a row are buffered and written as windows mirrored into all
+/// octants, in one transaction.
+void tft_draw_circle_aa(int16_t x, int16_t y, uint16_t r, uint16_t color, uint16_t bg_color)
+{
+    int16_t bx = x - r - 1, by = y - r - 1, bw = (r << 1) + 3, bh = bw;
+    if (!_tft_clip_rect(&bx, &by, &bw, &bh))
+    {
+        return;
+    }
+
+    int32_t v  = (int32_t)r * r;  // r^2 - cx^2
+    int32_t y2 = v;               // cy^2
+    int16_t cy = r;               // Integer part of sqrt(v)
+    int16_t cx = 0;               // Column
+    int16_t xa = 0;               // First column of the segment
+    uint8_t inner[AA_RUN_MAX];    // Levels on row cy
+    uint8_t outer[AA_RUN_MAX];    // Levels on row cy + 1
+    uint8_t len = 0;
+
+    _tft_aa_lut(color, bg_color);
+
+    START_WRITE();
+    for (;; cx++)
+    {
+        int16_t row = cy;
+        while (y2 > v && cy > 0)
+        {
+            y2 -= (cy << 1) - 1;
+            cy--;
+        }
+        if (len && (cy != row || cx > cy || len == AA_RUN_MAX))
+        {
+            _tft_write_aa_octants(x, y, xa, row, inner, outer, len);
+            len = 0;
+        }
+        if (cx > cy)
+        {
+            break;
+        }
+        if (!len)
+        {
+            xa = cx;
+        }
+
+        uint8_t level = _tft_aa_level(v - y2, (cy << 1) + 1);  // Fraction of sqrt(v)
+        inner[len]    = AA_LEVELS - level;
+        outer[len] = level;
+        len++;
+
+        v -= (cx << 1) + 1;
+    }
+
+    // The diagonal pixel (cx, cx) lies between the octants, blend it by its
+    // distance to the circle, |sqrt(2) * cx - r| ~ |2 * cx^2 - r^2| / 2r.
+    if (r)
+    {
+        int32_t t = ((int32_t)cx * cx << 1) - (int32_t)r * r;
+        uint8_t level[1];
+        level[0] = AA_LEVELS - _tft_aa_level((t < 0) ? -t : t, r << 1);
+        _tft_write_aa_span(x - cx, y - cx, 0, 1, level, 1);
+        _tft_write_aa_span(x + cx, y - cx, 0, 1, level, 1);
+        _tft_write_aa_span(x - cx, y + cx, 0, 1, level, 1);
+        _tft_write_aa_span(x + cx, y + cx, 0, 1, level, 1);
+    }
+    END_WRITE();
+}
+
+/// \brief Linear Gradient Walker
+/// \details RGB565 channels in 16.16 fixed point, stepped by addition.
+typedef struct
+{
+    int32_t r, g, b;     // Current channels
+    int32_t dr, dg, db;  // Steps
+} gradient_t;
+
+// 1-D ordered dither thresholds, in 1/256 of a channel step
+static const uint8_t _dither[4] = {0x20, 0xA0, 0x60, 0xE0};
+
+/// \brief Start a Linear Gradient
+/// \param g Gradient
+/// \param color0 First color
+/// \param color1 Last color
+/// \param n Number of steps from the first to the last color, included.
+/// \param skip Steps to skip, the clipped ones.
+static void _tft_gradient_init(gradient_t* g, uint16_t color0, uint16_t color1, int16_t n, int16_t skip)
+{
+    g->r  = (int32_t)(color0 >> 11) << 16;
+    g->g  = (int32_t)((color0 >> 5) & 0x3F) << 16;
+    g->b  = (int32_t)(color0 & 0x1F) << 16;
+    g->dr = 0;
+    g->dg = 0;
+    g->db = 0;
+    if (n > 1)
+    {
+        g->dr = (((int32_t)(color1 >> 11) << 16) - g->r) / (n - 1);
+        g->dg = (((int32_t)((color1 >> 5) & 0x3F) << 16) - g->g) / (n - 1);
+        g->db = (((int32_t)(color1 & 0x1F) << 16) - g->b) / (n - 1);
+    }
+    g->r += g->dr * skip;
+    g->g += g->dg * skip;
+    g->b += g->db * skip;
+}
+
+/// \brief Current Color of a Linear Gradient, then Step
+/// \param g Gradient
+/// \param threshold Rounding threshold, 0x80 to round to nearest.
+/// \return RGB565 color
+static uint16_t _tft_gradient_next(gradient_t* g, uint8_t threshold)
 {
-    _tft_draw_fast_h_line(x, y, width, color);
-    _tft_draw_fast_h_line(x, y + height - 1, width, color);
-    _tft_draw_fast_v_line(x, y, height, color);
-    _tft_draw_fast_v_line(x + width - 1, y, height, color);
+    uint16_t r  = (g->r + (threshold << 8)) >> 16;
+    uint16_t gr = (g->g + (threshold << 8)) >> 16;
+    uint16_t b  = (g->b + (threshold << 8)) >> 16;
+    g->r += g->dr;
+    g->g += g->dg;
+    g->b += g->db;
+    return ((r > 0x1F ? 0x1F : r) << 11) | ((gr > 0x3F ? 0x3F : gr) << 5) | (b > 0x1F ? 0x1F : b);
 }
 
-/// \brief Draw Line Function from Arduino GFX
-/// https://github.com/moononournation/Arduino_GFX/blob/master/src/Arduino_GFX.cpp
-/// \param x0 Start X coordinate
-/// \param y0 Start Y coordinate
-/// \param x1 End X coordinate
-/// \param y1 End Y coordinate
-/// \param color Line color
-void tft_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+/// \brief Fill a Rectangle with a Horizontal Gradient
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param color0 Left color
+/// \param color1 Right color
+/// \param dither Dither the columns to hide the RGB565 steps if non-zero.
+/// \details One row is rendered into the DMA buffer and repeated for every
+/// row by DMA. Dithering is ordered along the gradient only, so every row
+/// stays the same.
+void tft_fill_gradient_h(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color0, uint16_t color1, uint8_t dither)
 {
-    if (x0 == x1)
+    int16_t cx = x, cy = y, cw = width, ch = height;
+    if (!_tft_clip_rect(&cx, &cy, &cw, &ch))
     {
-        if (y0 > y1)
+        return;
+    }
+
+    gradient_t g;
+    _tft_gradient_init(&g, color0, color1, width, cx - x);
+
+    tft_wait();  // _buffer may still be queued
+
+    uint8_t* p = _buffer;
+    for (int16_t i = cx - x; i < cx - x + cw; i++)
+    {
+        uint16_t color = _tft_gradient_next(&g, dither ? _dither[i & 3] : 0x80);
+        *p++           = color >> 8;
+        *p++           = color;
+    }
+
+    START_WRITE();
+    _tft_set_window_rect(cx, cy, cw, ch);
+    DATA_MODE();
+    SPI_send_DMA(_buffer, cw << 1, ch);
+    END_WRITE();
+}
+
+/// \brief Fill a Rectangle with a Vertical Gradient
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param color0 Top color
+/// \param color1 Bottom color
+/// \param dither Dither the rows to hide the RGB565 steps if non-zero.
+/// \details Rows of the same color are merged into one solid fill, all in
+/// one transaction. Dithering is ordered along the gradient only, so every
+/// row stays solid.
+void tft_fill_gradient_v(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color0, uint16_t color1, uint8_t dither)
+{
+    int16_t cx = x, cy = y, cw = width, ch = height;
+    if (!_tft_clip_rect(&cx, &cy, &cw, &ch))
+    {
+        return;
+    }
+
+    gradient_t g;
+    _tft_gradient_init(&g, color0, color1, height, cy - y);
+
+    START_WRITE();
+    int16_t  start = cy;  // First row of the current color
+    uint16_t color = _tft_gradient_next(&g, dither ? _dither[(cy - y) & 3] : 0x80);
+    for (int16_t row = cy + 1; row < cy + ch; row++)
+    {
+        uint16_t next = _tft_gradient_next(&g, dither ? _dither[(row - y) & 3] : 0x80);
+        if (next != color)
         {
-            _swap_int16_t(y0, y1);
+            _tft_write_fill_rect(cx, start, cw, row - start, color);
+            start = row;
+            color = next;
         }
-        _tft_draw_fast_v_line(x0, y0, y1 - y0 + 1, color);
     }
-    else if (y0 == y1)
+    _tft_write_fill_rect(cx, start, cw, cy + ch - start, color);
+    END_WRITE();
+}
+
+/// \brief Fill a Rectangle with a Repeating Tile
+/// \param x Start X coordinate
+/// \param y Start Y coordinate
+/// \param width Width
+/// \param height Height
+/// \param tile Tile, RGB565 big endian like a bitmap, anchored at (x, y).
+/// \param tw Tile width
+/// \param th Tile height
+/// \details The whole area is one window. Tiles up to ST7735_WIDTH pixels are
+/// copied once into the DMA buffer, each row rotated to start at the first
+/// visible column and repeated as many times as the buffer holds, then every
+/// screen row is one buffered row repeated by DMA plus a partial tail.
+/// Larger tiles are sent from the tile itself, with an extra transfer for
+/// the partial head.
+void tft_fill_pattern(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* tile, uint16_t tw, uint16_t th)
+{
+    int16_t cx = x, cy = y, cw = width, ch = height;
+    if (!tw || !th || !_tft_clip_rect(&cx, &cy, &cw, &ch))
     {
-        if (x0 > x1)
+        return;
+    }
+
+    uint16_t       rw     = tw;              // Pixels per source row
+    uint16_t       stride = tw << 1;         // Bytes per source row
+    uint16_t       head   = (cx - x) % tw;   // Tile column of the first visible column
+    uint16_t       ty     = (cy - y) % th;   // Tile row of the first visible row
+    const uint8_t* rows   = tile;
+
+    if (tw * th <= ST7735_WIDTH)
+    {
+        uint16_t copies = ST7735_WIDTH / (tw * th);
+        if (copies > cw / tw + 1)
         {
-            _swap_int16_t(x0, x1);
+            copies = cw / tw + 1;
+        }
+        rw = tw * copies;
+
+        tft_wait();  // _buffer may still be queued
+
+        uint8_t* p = _buffer;
+        for (const uint8_t* row = tile; row < tile + stride * th; row += stride)
+        {
+            for (uint16_t i = 0, k = head; i < rw; i++)
+            {
+                *p++ = row[k << 1];
+                *p++ = row[(k << 1) + 1];
+                if (++k == tw)
+                {
+                    k = 0;
+                }
+            }
+        }
+        rows   = _buffer;
+        stride = rw << 1;
+        head   = 0;
+    }
+
+    // Same split on every row, head pixels, whole source rows, then tail pixels
+    uint16_t lead = head ? tw - head : 0;
+    if (lead > cw)
+    {
+        lead = cw;
+    }
+    uint16_t repeat = (cw - lead) / rw;
+    uint16_t tail   = (cw - lead) % rw;
+
+    START_WRITE();
+    _tft_set_window_rect(cx, cy, cw, ch);
+    DATA_MODE();
+    const uint8_t* row = rows + ty * stride;
+    while (ch--)
+    {
+        if (lead)
+        {
+            SPI_send_DMA(row + (head << 1), lead << 1, 1);
+        }
+        if (repeat)
+        {
+            SPI_send_DMA(row, stride, repeat);
+        }
+        if (tail)
+        {
+            SPI_send_DMA(row, tail << 1, 1);
+        }
+        row += stride;
+        if (++ty == th)
+        {
+            ty  = 0;
+            row = rows;
+        }
+    }
+    END_WRITE();
+}
+
+// tan(d) for d = 0 to 89 degrees, 6.10 fixed point
+static const uint16_t _tan_table[90] = {
+    0,    18,   36,   54,   72,   90,   108,  126,  144,   162,    //
+    181,  199,  218,  236,  255,  274,  294,  313,  333,   353,    //
+    373,  393,  414,  435,  456,  477,  499,  522,  544,   568,    //
+    591,  615,  640,  665,  691,  717,  744,  772,  800,   829,    //
+    859,  890,  922,  955,  989,  1024, 1060, 1098, 1137,  1178,   //
+    1220, 1265, 1311, 1359, 1409, 1462, 1518, 1577, 1639,  1704,   //
+    1774, 1847, 1926, 2010, 2100, 2196, 2300, 2412, 2534,  2668,   //
+    2813, 2974, 3152, 3349, 3571, 3822, 4107, 4435, 4818,  5268,   //
+    5807, 6465, 7286, 8340, 9743, 11704, 14644, 19539, 29324, 58665,  //
+};
+
+#define ARC_EDGE_NONE INT32_MAX  // Sector edge on the horizontal axis, never crossed
+
+/// \brief Write a Ring Sector
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Outer radius
+/// \param ir Inner radius, 0 for a pie.
+/// \param a0 Start angle, degrees clockwise from 12 o'clock
+/// \param a1 End angle, 0 <= a0 < a1 <= 360
+/// \param color Sector color
+/// \details The ring holds the pixels inside the circle of radius r and
+/// outside the one of radius ir - 1, with the same profile as the rounded
+/// rectangles. The sector holds the pixels whose direction is in [a0, a1),
+/// so sectors sharing an angle never overlap or leave a gap, which lets
+/// tft_update_ring() redraw only the part that changed.
+///
+/// Each quadrant is walked row by row. In a quadrant, the distance u from
+/// the vertical axis grows with the angle phi from that axis, and an edge
+/// at phi crosses row k at u = k * tan(phi), stepped by adding tan(phi).
+/// Spans are written as fast h-lines, the caller holds CS.
+static void _tft_write_arc(int16_t x, int16_t y, int16_t r, int16_t ir, int16_t a0, int16_t a1, uint16_t color)
+{
+    int32_t  lo[4], hi[4];    // Edges on the current row, 22.10 fixed point
+    uint16_t dlo[4], dhi[4];  // Edge steps per row
+    uint8_t  quadrants = 0;   // Quadrants in the sector, bit 0 is 12 to 3 o'clock
+
+    int16_t base = 0;  // First angle of the quadrant
+    for (uint8_t q = 0; q < 4; q++, base += 90)
+    {
+        int16_t s = (a0 > base) ? a0 : base;
+        int16_t e = (a1 < base + 90) ? a1 : base + 90;
+        if (s >= e)
+        {
+            continue;
+        }
+        quadrants |= 1 << q;
+
+        // Angles from the vertical axis, odd quadrants run toward it
+        int16_t p0 = (q & 1) ? base + 90 - e : s - base;
+        int16_t p1 = (q & 1) ? base + 90 - s : e - base;
+        dlo[q]     = _tan_table[p0];
+        lo[q]      = (int32_t)r * dlo[q];
+        dhi[q]     = (p1 < 90) ? _tan_table[p1] : 0;
+        hi[q]      = (p1 < 90) ? (int32_t)r * dhi[q] : ARC_EDGE_NONE;
+    }
+
+    arc_t outer, inner = {0};  // The inner profile starts at the hole
+    _tft_arc_init(&outer, r);
+    for (int16_t k = r; k >= 0; k--)
+    {
+        if (k < r)
+        {
+            _tft_arc_step(&outer, k);
+        }
+        int16_t u_min = 0;  // First pixel outside the hole
+        if (k == ir - 1)
+        {
+            _tft_arc_init(&inner, ir - 1);
+        }
+        else if (k < ir - 1)
+        {
+            _tft_arc_step(&inner, k);
+        }
+        if (k < ir)
+        {
+            u_min = inner.x + 1;
+        }
+
+        for (uint8_t q = 0; q < 4; q++)
+        {
+            if (!(quadrants & (1 << q)))
+            {
+                continue;
+            }
+
+            // Edges are [lo, hi) in even quadrants, (lo, hi] in odd ones,
+            // the axis column belongs to the even ones, the axis row to
+            // the odd ones.
+            int16_t u0, u1;
+            if (q & 1)
+            {
+                u0 = (lo[q] >> 10) + 1;
+                u1 = (hi[q] == ARC_EDGE_NONE) ? outer.x : hi[q] >> 10;
+            }
+            else
+            {
+                u0 = (lo[q] + 1023) >> 10;
+                u1 = (hi[q] == ARC_EDGE_NONE) ? outer.x : ((hi[q] + 1023) >> 10) - 1;
+            }
+            lo[q] -= dlo[q];
+            if (hi[q] != ARC_EDGE_NONE)
+            {
+                hi[q] -= dhi[q];
+            }
+
+            if (u0 < u_min)
+            {
+                u0 = u_min;
+            }
+            if (u1 > outer.x)
+            {
+                u1 = outer.x;
+            }
+            if (u0 > u1 || (k == 0 && !(q & 1)))
+            {
+                continue;
+            }
+            int16_t row = (q == 0 || q == 3) ? y - k : y + k;
+            int16_t col = (q < 2) ? x + u0 : x - u1;
+            _tft_write_fast_h_line(col, row, u1 - u0 + 1, color);
+        }
+    }
+
+    if (ir == 0 && a0 == 0)
+    {
+        _tft_write_fast_h_line(x, y, 1, color);  // Center, counted at 0 degrees
+    }
+}
+
+/// \brief Write a Ring Sector of Any Angles
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Outer radius
+/// \param ir Inner radius, 0 for a pie.
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle, a whole ring if 360 or more after start.
+/// \param color Sector color
+/// \details Angles are brought into [0, 360), a sector across 12 o'clock
+/// is written in two parts. The caller holds CS.
+static void _tft_write_sector(int16_t x, int16_t y, uint16_t r, uint16_t ir, int16_t start, int16_t end, uint16_t color)
+{
+    int16_t sweep = end - start;
+    if (sweep <= 0 || ir > r)
+    {
+        return;
+    }
+    if (sweep >= 360)
+    {
+        _tft_write_arc(x, y, r, ir, 0, 360, color);
+        return;
+    }
+    while (start < 0)
+    {
+        start += 360;
+    }
+    while (start >= 360)
+    {
+        start -= 360;
+    }
+    end = start + sweep;
+    if (end > 360)
+    {
+        _tft_write_arc(x, y, r, ir, start, 360, color);
+        _tft_write_arc(x, y, r, ir, 0, end - 360, color);
+    }
+    else
+    {
+        _tft_write_arc(x, y, r, ir, start, end, color);
+    }
+}
+
+/// \brief Draw an Arc
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Arc color
+void tft_draw_arc(int16_t x, int16_t y, uint16_t r, int16_t start, int16_t end, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_sector(x, y, r, r, start, end, color);
+    END_WRITE();
+}
+
+/// \brief Fill a Thick Arc
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Outer radius
+/// \param ir Inner radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Fill color
+void tft_fill_arc(int16_t x, int16_t y, uint16_t r, uint16_t ir, int16_t start, int16_t end, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_sector(x, y, r, ir, start, end, color);
+    END_WRITE();
+}
+
+/// \brief Fill a Pie Slice
+/// \param x Center X coordinate
+/// \param y Center Y coordinate
+/// \param r Radius
+/// \param start Start angle, degrees clockwise from 12 o'clock
+/// \param end End angle
+/// \param color Fill color
+void tft_fill_pie(int16_t x, int16_t y, uint16_t r, int16_t start, int16_t end, uint16_t color)
+{
+    START_WRITE();
+    _tft_write_sector(x, y, r, 0, start, end, color);
+    END_WRITE();
+}
+
+/// \brief Angle of a Ring Gauge Value
+/// \param ring Ring gauge, scale set.
+/// \param value Value, clamped to the full scale.
+/// \return Angle, degrees clockwise from 12 o'clock
+/// \details Shift-and-add multiplication by the scale, no division. The
+/// scale is rounded up, so the angle is exact while value * max_value stays
+/// below 2^23. The product stays below sweep << 23 plus value, in 32 bits.
+static int16_t _tft_ring_angle(const ring_t* ring, uint16_t value)
+{
+    if (value >= ring->max_value)
+    {
+        return ring->start + ring->sweep;
+    }
+    uint32_t angle = 0;
+    for (uint32_t scale = ring->scale; value; value >>= 1, scale <<= 1)
+    {
+        if (value & 1)
+        {
+            angle += scale;
         }
-        _tft_draw_fast_h_line(x0, y0, x1 - x0 + 1, color);
+    }
+    return ring->start + (int16_t)(angle >> 23);
+}
+
+/// \brief Draw a Ring Gauge
+/// \param ring Ring gauge, its scale is set.
+/// \param value Value
+/// \details The value part and the track are drawn in one transaction. The
+/// only division of the gauge computes the scale here, updates multiply.
+void tft_draw_ring(ring_t* ring, uint16_t value)
+{
+    ring->scale = ring->max_value ? (((uint32_t)ring->sweep << 23) + ring->max_value - 1) / ring->max_value : 0;
+    int16_t angle = _tft_ring_angle(ring, value);
+
+    START_WRITE();
+    _tft_write_sector(ring->x, ring->y, ring->r, ring->ir, ring->start, angle, ring->color);
+    _tft_write_sector(ring->x, ring->y, ring->r, ring->ir, angle, ring->start + ring->sweep, ring->bg_color);
+    END_WRITE();
+}
+
+/// \brief Update a Ring Gauge
+/// \param ring Ring gauge, drawn with tft_draw_ring() before.
+/// \param old_value Value shown now
+/// \param new_value Value to show
+/// \details Only the sector between the two values is redrawn, in the ring
+/// color when the value grows, in the track color when it shrinks.
+void tft_update_ring(const ring_t* ring, uint16_t old_value, uint16_t new_value)
+{
+    int16_t a0 = _tft_ring_angle(ring, old_value);
+    int16_t a1 = _tft_ring_angle(ring, new_value);
+
+    START_WRITE();
+    if (a1 > a0)
+    {
+        _tft_write_sector(ring->x, ring->y, ring->r, ring->ir, a0, a1, ring->color);
     }
     else
     {
-        _tft_draw_line_bresenham(x0, y0, x1, y1, color);
+        _tft_write_sector(ring->x, ring->y, ring->r, ring->ir, a1, a0, ring->bg_color);
     }
+    END_WRITE();
 }
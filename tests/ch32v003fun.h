@@ -0,0 +1,152 @@
+/// \brief Host Register Model of ch32v003fun for the ST7735 Driver
+///
+/// \details Replaces ch32v003fun.h when st7735.c is compiled on a PC. Only the
+/// registers, constants and functions used by the driver are defined, with the
+/// values of ch32v003fun. Every peripheral access calls emu_sync() first, so
+/// the emulator sees the register writes in program order and updates the
+/// status registers before they are read. See emulator.c.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#ifndef __CH32V003FUN_H
+#define __CH32V003FUN_H
+
+#include <stdint.h>
+
+// The DMA interrupt handler is an ordinary function on the host.
+#define interrupt
+
+// Registers, 32-bit so SPI DATAR can hold the emulator's "no write" marker.
+typedef struct
+{
+    volatile uint32_t CFGLR;
+    volatile uint32_t CFGHR;
+    volatile uint32_t INDR;
+    volatile uint32_t OUTDR;
+    volatile uint32_t BSHR;
+    volatile uint32_t BCR;
+    volatile uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CTLR1;
+    volatile uint32_t CTLR2;
+    volatile uint32_t STATR;
+    volatile uint32_t DATAR;
+    volatile uint32_t CRCR;
+} SPI_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CFGR;
+    volatile uint32_t CNTR;
+    volatile uint32_t PADDR;
+    volatile uint32_t MADDR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t INTFR;
+    volatile uint32_t INTFCR;
+} DMA_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t AHBPCENR;
+    volatile uint32_t APB2PCENR;
+} RCC_TypeDef;
+
+extern GPIO_TypeDef        emu_gpioc;
+extern SPI_TypeDef         emu_spi1;
+extern DMA_TypeDef         emu_dma1;
+extern DMA_Channel_TypeDef emu_dma1_channel3;
+extern RCC_TypeDef         emu_rcc;
+
+void emu_sync(void);
+
+#define GPIOC         (emu_sync(), &emu_gpioc)
+#define SPI1          (emu_sync(), &emu_spi1)
+#define DMA1          (emu_sync(), &emu_dma1)
+#define DMA1_Channel3 (emu_sync(), &emu_dma1_channel3)
+#define RCC           (emu_sync(), &emu_rcc)
+
+// Interrupts
+typedef enum
+{
+    DMA1_Channel3_IRQn = 24,  // DMA1 Channel 3 global Interrupt
+} IRQn_Type;
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void __enable_irq(void);
+void __disable_irq(void);
+void DMA1_Channel3_IRQHandler(void);
+
+// Delays, no time passes on the host
+void Delay_Ms(uint32_t n);
+void Delay_Us(uint32_t n);
+
+// RCC
+#define RCC_AHBPeriph_DMA1   ((uint32_t)0x00000001)
+#define RCC_APB2Periph_GPIOC ((uint32_t)0x00000010)
+#define RCC_APB2Periph_SPI1  ((uint32_t)0x00001000)
+
+// GPIO
+#define GPIO_CNF_IN_FLOATING 4
+#define GPIO_CNF_OUT_PP      0
+#define GPIO_CNF_OUT_PP_AF   8
+
+typedef enum
+{
+    GPIO_Speed_In,
+    GPIO_Speed_10MHz,
+    GPIO_Speed_2MHz,
+    GPIO_Speed_50MHz
+} GPIOSpeed_TypeDef;
+
+// SPI
+#define CTLR1_SPE_Set           ((uint16_t)0x0040)
+#define SPI_CTLR1_SPE           ((uint16_t)0x0040)
+#define SPI_CTLR1_DFF           ((uint16_t)0x0800)
+#define SPI_STATR_TXE           ((uint8_t)0x02)
+#define SPI_STATR_BSY           ((uint8_t)0x80)
+#define SPI_Direction_1Line_Tx  ((uint16_t)0xC000)
+#define SPI_Mode_Master         ((uint16_t)0x0104)
+#define SPI_DataSize_16b        ((uint16_t)0x0800)
+#define SPI_DataSize_8b         ((uint16_t)0x0000)
+#define SPI_CPOL_Low            ((uint16_t)0x0000)
+#define SPI_CPHA_1Edge          ((uint16_t)0x0000)
+#define SPI_NSS_Soft            ((uint16_t)0x0200)
+#define SPI_BaudRatePrescaler_2 ((uint16_t)0x0000)
+#define SPI_FirstBit_MSB        ((uint16_t)0x0000)
+#define SPI_I2S_DMAReq_Tx       ((uint16_t)0x0002)
+
+// DMA
+#define DMA_CFGR1_EN                    ((uint16_t)0x0001)
+#define DMA_CFGR1_TCIE                  ((uint16_t)0x0002)
+#define DMA_CFGR1_CIRC                  ((uint16_t)0x0020)
+#define DMA_CFGR1_MINC                  ((uint16_t)0x0080)
+#define DMA_CFGR1_PSIZE                 ((uint16_t)0x0300)
+#define DMA_CFGR1_MSIZE                 ((uint16_t)0x0C00)
+#define DMA_DIR_PeripheralDST           ((uint32_t)0x00000010)
+#define DMA_PeripheralInc_Disable       ((uint32_t)0x00000000)
+#define DMA_MemoryInc_Enable            ((uint32_t)0x00000080)
+#define DMA_MemoryInc_Disable           ((uint32_t)0x00000000)
+#define DMA_PeripheralDataSize_Byte     ((uint32_t)0x00000000)
+#define DMA_PeripheralDataSize_HalfWord ((uint32_t)0x00000100)
+#define DMA_MemoryDataSize_Byte         ((uint32_t)0x00000000)
+#define DMA_MemoryDataSize_HalfWord     ((uint32_t)0x00000400)
+#define DMA_Mode_Circular               ((uint32_t)0x00000020)
+#define DMA_Mode_Normal                 ((uint32_t)0x00000000)
+#define DMA_Priority_VeryHigh           ((uint32_t)0x00003000)
+#define DMA_M2M_Disable                 ((uint32_t)0x00000000)
+#define DMA_IT_TC                       ((uint32_t)0x00000002)
+#define DMA1_IT_GL3                     ((uint32_t)0x00000100)
+#define DMA1_IT_TC3                     ((uint32_t)0x00000200)
+#define DMA1_FLAG_GL3                   ((uint32_t)0x00000100)
+#define DMA1_FLAG_TC3                   ((uint32_t)0x00000200)
+#define DMA1_FLAG_HT3                   ((uint32_t)0x00000400)
+#define DMA1_FLAG_TE3                   ((uint32_t)0x00000800)
+
+#endif  // __CH32V003FUN_H
@@ -0,0 +1,129 @@
+/// \brief Checks of the Host Tests
+///
+/// \details CHECK() counts the failed conditions of a test. A screen is
+/// either drawn by a reference on the host or saved from the emulator, and
+/// compared with what the emulator shows. Randomized tests draw from a fixed
+/// sequence, so a failure repeats on every run.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#ifndef __CHECK_H__
+#define __CHECK_H__
+
+#include <stdio.h>
+
+#include "emulator.h"
+#include "st7735.h"
+
+#define CHECK(cond)                                                            \
+    do                                                                         \
+    {                                                                          \
+        if (!(cond))                                                           \
+        {                                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            _failures++;                                                       \
+        }                                                                      \
+    } while (0)
+
+static int _failures = 0;
+
+/// \brief Screen in the Orientation of the Driver
+typedef uint16_t screen_t[ST7735_HEIGHT][ST7735_WIDTH];
+
+/// \brief Random Number
+/// \param lo Lowest value
+/// \param hi Highest value
+/// \return Value from lo to hi, xorshift32 from a fixed seed.
+static inline int32_t check_random(int32_t lo, int32_t hi)
+{
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return lo + (int32_t)(state % (uint32_t)(hi - lo + 1));
+}
+
+/// \brief Set a Pixel of a Reference Screen
+/// \details Pixels off the screen are dropped, like the driver clips them.
+static inline void check_pixel(screen_t screen, int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT)
+    {
+        screen[y][x] = color;
+    }
+}
+
+/// \brief Fill the Panel and a Reference Screen
+/// \param screen Reference screen
+/// \param color Color of both
+/// \details Nothing is sent on the wire, the statistics are reset.
+static inline void check_clear(screen_t screen, uint16_t color)
+{
+    tft_wait();
+    emu_flush();
+    emu_fill(color);
+    for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < ST7735_WIDTH; x++)
+        {
+            screen[y][x] = color;
+        }
+    }
+    emu_reset_stats();
+}
+
+/// \brief Save the Screen Shown by the Emulator
+static inline void check_save(screen_t screen)
+{
+    for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < ST7735_WIDTH; x++)
+        {
+            screen[y][x] = emu_pixel(x, y);
+        }
+    }
+}
+
+/// \brief Count the Pixels Differing from a Screen
+/// \param screen Expected screen
+/// \param what Printed with the first mismatch
+static inline uint32_t check_mismatches(screen_t screen, const char* what)
+{
+    uint32_t n = 0;
+    for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < ST7735_WIDTH; x++)
+        {
+            if (emu_pixel(x, y) != screen[y][x])
+            {
+                if (!n)
+                {
+                    printf("%s: first mismatch at (%d, %d): %04x, expected %04x\n", what, x, y, emu_pixel(x, y),
+                           screen[y][x]);
+                }
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+/// \brief Count the Pixels Differing from a Screen Once Everything Is Sent
+/// \param screen Expected screen
+/// \param what Printed with the first mismatch
+static inline uint32_t check_screen(screen_t screen, const char* what)
+{
+    tft_wait();
+    emu_flush();
+    return check_mismatches(screen, what);
+}
+
+/// \brief Print the Result of the Test
+/// \return Exit code, 0 if every check passed.
+static inline int check_result(void)
+{
+    printf("%s\n", _failures ? "FAIL" : "PASS");
+    return _failures != 0;
+}
+
+#endif  // __CHECK_H__
@@ -0,0 +1,822 @@
+/// \brief ST7735 Emulator for Host Builds of the Driver
+///
+/// \details See emulator.h. The model follows the parts of the chip the
+/// driver relies on:
+///  - GPIOC drives RESET (PC2), DC (PC3) and CS (PC4). A CS pin that is not
+///    an output is taken as CS wired to ground (ST7735_NO_CS).
+///  - SPI1 has a transmit buffer and a shift register. TXE is set when the
+///    buffer is empty, BSY while a frame is in the buffer or being shifted.
+///    Frames are 8 or 16 bits (DFF), sent MSB first.
+///  - DMA1 channel 3 moves one element into an empty transmit buffer per
+///    request, with the memory increment, element size, circular mode and
+///    transfer complete interrupt of CFGR. TC is set when the last element
+///    has been moved, before it is shifted out.
+///  - The panel decodes the bytes received while CS is low, a command when DC
+///    is low, its parameters when DC is high. Only the 16-bit pixel format is
+///    modelled, pixels sent in another format are not written.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "emulator.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include "ch32v003fun.h"
+
+// Pins of st7735.c
+#define PIN_RESET 2  // PC2
+#define PIN_DC    3  // PC3
+#define PIN_CS    4  // PC4
+
+// Panel memory, in columns and rows of the panel
+#define GRAM_COLS 132
+#define GRAM_ROWS 162
+
+// Visible area of the 0.96" 80x160 panel
+#define VISIBLE_X0 26  // First visible column
+#define VISIBLE_W  80
+#define VISIBLE_Y0 1  // First visible row
+#define VISIBLE_H  160
+
+// The IPS panel of the module shows its memory inverted, INVON restores the
+// colors.
+#define PANEL_INVERTED 1
+
+// Commands
+#define CMD_NORON   0x13
+#define CMD_INVOFF  0x20
+#define CMD_INVON   0x21
+#define CMD_CASET   0x2A
+#define CMD_RASET   0x2B
+#define CMD_RAMWR   0x2C
+#define CMD_VSCRDEF 0x33
+#define CMD_MADCTL  0x36
+#define CMD_VSCSAD  0x37
+#define CMD_COLMOD  0x3A
+
+// MADCTL
+#define MADCTL_MY 0x80  // Row address order
+#define MADCTL_MX 0x40  // Column address order
+#define MADCTL_MV 0x20  // Row/column exchange
+
+// COLMOD
+#define COLMOD_MASK   0x07  // Interface pixel format
+#define COLMOD_16_BPP 0x05
+#define COLMOD_18_BPP 0x06  // After reset
+
+#define DATAR_EMPTY 0xFFFFFFFF  // SPI DATAR has not been written
+#define DMA_FLAGS3  (DMA1_FLAG_TC3 | DMA1_FLAG_HT3 | DMA1_FLAG_TE3)
+
+#define TIMER_US   100      // Interval of the timer signal
+#define RUN_TICKS  1000000  // Most ticks run while the CPU waits
+#define STACK_SIZE (1 << 20)
+
+// Keeps the compiler from moving emulator state changes out of a _busy section
+#define BARRIER() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+GPIO_TypeDef        emu_gpioc;
+SPI_TypeDef         emu_spi1;
+DMA_TypeDef         emu_dma1;
+DMA_Channel_TypeDef emu_dma1_channel3;
+RCC_TypeDef         emu_rcc;
+
+emu_stats_t emu_stats;
+const char* emu_violation = 0;
+uint16_t    emu_spi_ticks = 4;
+
+// Register values seen so far, writes are found by comparing
+static uint32_t _pins  = 0;  // Output levels of GPIOC
+static uint32_t _ctlr1 = 0;  // SPI1 CTLR1
+static uint32_t _cfgr  = 0;  // DMA1 channel 3 CFGR
+
+// SPI transmit buffer and shift register
+static uint8_t  _tx_full     = 0;
+static uint16_t _tx          = 0;
+static uint8_t  _tx_16       = 0;  // 16-bit frame
+static uint8_t  _shift_busy  = 0;
+static uint16_t _shift       = 0;
+static uint8_t  _shift_16    = 0;
+static uint16_t _shift_ticks = 0;  // Ticks until the frame has left
+
+// DMA channel
+static uint8_t  _dma_on      = 0;
+static uint32_t _dma_start   = 0;  // Memory address of a pass
+static uint16_t _dma_count   = 0;  // Elements of a pass
+static uint32_t _dma_addr    = 0;
+static uint16_t _dma_left    = 0;  // Elements left in this pass
+static uint8_t  _dma_request = 0;  // The transmit buffer is empty, served on the next tick
+
+// Interrupts, shared with the timer signal
+static volatile sig_atomic_t _irq_enabled = 0;  // Enabled in the NVIC
+static volatile sig_atomic_t _irq_global  = 0;  // Interrupts enabled
+static volatile sig_atomic_t _busy        = 0;  // Emulator state is being changed
+static volatile sig_atomic_t _in_irq      = 0;  // The interrupt handler is running
+static volatile uint32_t     _accesses    = 0;  // Register accesses of the CPU
+static uint32_t              _seen        = 0;  // Register accesses at the last timer signal
+
+// Panel
+static uint16_t _gram[GRAM_ROWS][GRAM_COLS];
+static uint8_t  _cmd    = 0;
+static uint8_t  _nparam = 0;  // Parameters received for _cmd
+static uint8_t  _param[6];
+static uint16_t _xs = 0, _xe = 0, _ys = 0, _ye = 0;  // Address window
+static uint16_t _x = 0, _y = 0;                      // Address counter
+static uint8_t  _madctl = 0;
+static uint8_t  _colmod = COLMOD_18_BPP;
+static uint8_t  _invert = 0;  // Display inversion on
+static uint8_t  _scroll = 0;  // Vertical scroll mode
+static uint16_t _tfa = 0, _vsa = 0, _bfa = 0, _ssa = 0;
+
+/// \brief Record an Error of the Driver
+/// \param what Description
+static void _violate(const char* what)
+{
+    emu_stats.violations++;
+    if (!emu_violation)
+    {
+        emu_violation = what;
+    }
+}
+
+/// \brief Check Whether Data Is Still Being Sent
+static uint8_t _spi_busy(void)
+{
+    return _tx_full || _shift_busy || (_dma_on && _dma_left);
+}
+
+/// \brief Check Whether a Pin Is an Output
+static uint8_t _pin_output(uint8_t pin)
+{
+    return (emu_gpioc.CFGLR >> (pin << 2)) & 0x3;  // MODE, 0 - Input
+}
+
+/// \brief Check Whether the Panel Is Selected
+static uint8_t _selected(void)
+{
+    return !_pin_output(PIN_CS) || !(_pins & (1 << PIN_CS));
+}
+
+/// \brief Reset the Panel
+/// \details Memory keeps its content.
+static void _panel_reset(void)
+{
+    _cmd    = 0;
+    _nparam = 0;
+    _madctl = 0;
+    _colmod = COLMOD_18_BPP;
+    _invert = 0;
+    _scroll = 0;
+    _xs     = 0;
+    _xe     = GRAM_COLS - 1;
+    _ys     = 0;
+    _ye     = GRAM_ROWS - 1;
+    _x      = 0;
+    _y      = 0;
+    _tfa    = 0;
+    _vsa    = GRAM_ROWS;
+    _bfa    = 0;
+    _ssa    = 0;
+}
+
+/// \brief Find the Memory Location of an Address
+/// \param x Column address, from CASET
+/// \param y Row address, from RASET
+/// \param col Panel column
+/// \param row Panel row
+/// \return 0 if the address is outside the memory.
+static uint8_t _locate(uint16_t x, uint16_t y, uint16_t* col, uint16_t* row)
+{
+    *col = (_madctl & MADCTL_MV) ? y : x;
+    *row = (_madctl & MADCTL_MV) ? x : y;
+    if (*col >= GRAM_COLS || *row >= GRAM_ROWS)
+    {
+        return 0;
+    }
+    if (_madctl & MADCTL_MX)
+    {
+        *col = GRAM_COLS - 1 - *col;
+    }
+    if (_madctl & MADCTL_MY)
+    {
+        *row = GRAM_ROWS - 1 - *row;
+    }
+    return 1;
+}
+
+/// \brief Receive a Command
+static void _panel_command(uint8_t cmd)
+{
+    emu_stats.commands++;
+    _cmd    = cmd;
+    _nparam = 0;
+    switch (cmd)
+    {
+        case CMD_NORON:
+            _scroll = 0;
+            break;
+        case CMD_INVOFF:
+            _invert = 0;
+            break;
+        case CMD_INVON:
+            _invert = 1;
+            break;
+        case CMD_CASET:
+            emu_stats.caset++;
+            break;
+        case CMD_RASET:
+            emu_stats.raset++;
+            break;
+        case CMD_RAMWR:
+            emu_stats.windows++;
+            _x = _xs;
+            _y = _ys;
+            break;
+    }
+}
+
+/// \brief Receive a Pixel Byte
+static void _panel_pixel(uint8_t data)
+{
+    if (!(_nparam++ & 1))
+    {
+        _param[0] = data;  // High byte
+        return;
+    }
+
+    uint16_t col, row;
+    emu_stats.pixels++;
+    if ((_colmod & COLMOD_MASK) != COLMOD_16_BPP)
+    {
+        col = row = 0;  // Not decoded, the address still advances
+    }
+    else if (_locate(_x, _y, &col, &row))
+    {
+        _gram[row][col] = _param[0] << 8 | data;
+    }
+    else
+    {
+        col = row = 0;
+    }
+    if (col < VISIBLE_X0 || col >= VISIBLE_X0 + VISIBLE_W || row < VISIBLE_Y0 || row >= VISIBLE_Y0 + VISIBLE_H)
+    {
+        emu_stats.hidden++;
+    }
+
+    // Next address in the window
+    if (_x < _xe)
+    {
+        _x++;
+    }
+    else
+    {
+        _x = _xs;
+        _y = _y < _ye ? _y + 1 : _ys;
+    }
+}
+
+/// \brief Receive a Parameter
+static void _panel_data(uint8_t data)
+{
+    if (_cmd == CMD_RAMWR)
+    {
+        _panel_pixel(data);
+        return;
+    }
+
+    if (_nparam < sizeof(_param))
+    {
+        _param[_nparam] = data;
+    }
+    _nparam++;
+
+    switch (_cmd)
+    {
+        case CMD_CASET:
+            if (_nparam == 4)
+            {
+                _xs = _param[0] << 8 | _param[1];
+                _xe = _param[2] << 8 | _param[3];
+            }
+            break;
+        case CMD_RASET:
+            if (_nparam == 4)
+            {
+                _ys = _param[0] << 8 | _param[1];
+                _ye = _param[2] << 8 | _param[3];
+            }
+            break;
+        case CMD_MADCTL:
+            _madctl = data;
+            break;
+        case CMD_COLMOD:
+            _colmod = data;
+            if ((data & COLMOD_MASK) != COLMOD_16_BPP)
+            {
+                _violate("COLMOD set to a pixel format other than 16 bits");
+            }
+            break;
+        case CMD_VSCRDEF:
+            if (_nparam == 6)
+            {
+                _tfa = _param[0] << 8 | _param[1];
+                _vsa = _param[2] << 8 | _param[3];
+                _bfa = _param[4] << 8 | _param[5];
+            }
+            break;
+        case CMD_VSCSAD:
+            if (_nparam == 2)
+            {
+                _ssa    = _param[0] << 8 | _param[1];
+                _scroll = 1;
+            }
+            break;
+    }
+}
+
+/// \brief A Byte Has Left the Shift Register
+static void _panel_receive(uint8_t data)
+{
+    if (!_selected())
+    {
+        return;
+    }
+    emu_stats.bytes++;
+    if (_pins & (1 << PIN_DC))
+    {
+        _panel_data(data);
+    }
+    else
+    {
+        _panel_command(data);
+    }
+}
+
+/// \brief Change the Output Levels of GPIOC
+static void _set_pins(uint32_t pins)
+{
+    uint32_t changed = pins ^ _pins;
+
+    if ((changed & (1 << PIN_DC | 1 << PIN_CS)) && _spi_busy())
+    {
+        _violate("DC or CS changed while data was being sent");
+    }
+    if ((changed & (1 << PIN_CS)) && (pins & (1 << PIN_CS)) && _pin_output(PIN_CS))
+    {
+        emu_stats.transactions++;
+        _cmd = 0;  // A command ends with the transaction
+    }
+    if ((changed & (1 << PIN_RESET)) && !(pins & (1 << PIN_RESET)) && _pin_output(PIN_RESET))
+    {
+        _panel_reset();
+    }
+    _pins = pins;
+}
+
+/// \brief Put a Frame in the SPI Transmit Buffer
+static void _spi_write(uint16_t frame)
+{
+    _tx      = frame;
+    _tx_16   = (_ctlr1 & SPI_CTLR1_DFF) != 0;
+    _tx_full = 1;
+}
+
+/// \brief Move One Element from Memory to SPI
+static void _dma_move(void)
+{
+    const uint8_t* p = (const uint8_t*)(uintptr_t)_dma_addr;
+    uint16_t       frame;
+    uint8_t        size = (_cfgr & DMA_CFGR1_MSIZE) ? 2 : 1;
+
+    if (size == 2)
+    {
+        memcpy(&frame, p, 2);
+    }
+    else
+    {
+        frame = *p;
+    }
+    if (_cfgr & DMA_CFGR1_MINC)
+    {
+        _dma_addr += size;
+    }
+    _spi_write(frame);
+
+    if (!--_dma_left)
+    {
+        emu_dma1.INTFR |= DMA1_FLAG_TC3 | DMA1_FLAG_GL3;
+        if (_cfgr & DMA_CFGR1_CIRC)
+        {
+            _dma_addr = _dma_start;
+            _dma_left = _dma_count;
+        }
+    }
+}
+
+/// \brief Apply the Register Writes Since the Last Access
+static void _commit(void)
+{
+    // GPIO
+    uint32_t pins = _pins;
+    if (emu_gpioc.BSHR)
+    {
+        pins |= emu_gpioc.BSHR & 0xFFFF;
+        pins &= ~(emu_gpioc.BSHR >> 16);
+        emu_gpioc.BSHR = 0;
+    }
+    if (emu_gpioc.BCR)
+    {
+        pins &= ~(emu_gpioc.BCR & 0xFFFF);
+        emu_gpioc.BCR = 0;
+    }
+    if (pins != _pins)
+    {
+        _set_pins(pins);
+    }
+
+    // SPI
+    if (emu_spi1.CTLR1 != _ctlr1)
+    {
+        if (((emu_spi1.CTLR1 ^ _ctlr1) & (SPI_CTLR1_SPE | SPI_CTLR1_DFF)) && _spi_busy())
+        {
+            _violate("SPI frame format changed while data was being sent");
+        }
+        _ctlr1 = emu_spi1.CTLR1;
+    }
+    if (emu_spi1.DATAR != DATAR_EMPTY)
+    {
+        if (_dma_on && _dma_left)
+        {
+            _violate("DATAR written during a DMA transfer");
+        }
+        else if (_tx_full)
+        {
+            _violate("DATAR written with a full transmit buffer");
+        }
+        _spi_write(emu_spi1.DATAR);
+        emu_spi1.DATAR = DATAR_EMPTY;
+    }
+
+    // DMA
+    if (emu_dma1.INTFCR)
+    {
+        uint32_t clear = emu_dma1.INTFCR;
+        if (clear & DMA1_FLAG_GL3)
+        {
+            clear |= DMA_FLAGS3;
+        }
+        emu_dma1.INTFR &= ~clear;
+        if (!(emu_dma1.INTFR & DMA_FLAGS3))
+        {
+            emu_dma1.INTFR &= ~DMA1_FLAG_GL3;
+        }
+        emu_dma1.INTFCR = 0;
+    }
+    if (emu_dma1_channel3.CFGR != _cfgr)
+    {
+        uint32_t on = emu_dma1_channel3.CFGR & DMA_CFGR1_EN;
+        if (on && !(_cfgr & DMA_CFGR1_EN))
+        {
+            _dma_on      = 1;
+            _dma_start   = emu_dma1_channel3.MADDR;
+            _dma_count   = emu_dma1_channel3.CNTR;
+            _dma_addr    = _dma_start;
+            _dma_left    = _dma_count;
+            _dma_request = 0;
+            emu_stats.dma_transfers++;
+            if (_in_irq)
+            {
+                emu_stats.dma_chained++;
+            }
+        }
+        else if (!on)
+        {
+            _dma_on = 0;
+        }
+        _cfgr = emu_dma1_channel3.CFGR;
+    }
+}
+
+/// \brief Advance Time by One Tick
+static void _tick(void)
+{
+    if (_ctlr1 & SPI_CTLR1_SPE)
+    {
+        if (_shift_busy && !--_shift_ticks)
+        {
+            _shift_busy = 0;
+            if (_shift_16)
+            {
+                _panel_receive(_shift >> 8);
+            }
+            _panel_receive(_shift);
+        }
+        if (!_shift_busy && _tx_full)
+        {
+            _shift       = _tx;
+            _shift_16    = _tx_16;
+            _shift_ticks = emu_spi_ticks << _shift_16;
+            _shift_busy  = 1;
+            _tx_full     = 0;
+        }
+    }
+
+    if (_dma_on && _dma_left && !_tx_full)
+    {
+        if (_dma_request)
+        {
+            _dma_request = 0;
+            _dma_move();
+        }
+        else
+        {
+            _dma_request = 1;
+        }
+    }
+
+    emu_spi1.STATR = (_tx_full ? 0 : SPI_STATR_TXE) | (_tx_full || _shift_busy ? SPI_STATR_BSY : 0);
+}
+
+/// \brief Check Whether the DMA Interrupt Is Raised and Enabled
+static uint8_t _irq_ready(void)
+{
+    return (emu_dma1.INTFR & DMA1_FLAG_TC3) && (_cfgr & DMA_CFGR1_TCIE) && _irq_enabled && _irq_global && !_in_irq;
+}
+
+/// \brief Take the DMA Interrupt
+/// \details Called with _busy set. The handler runs like driver code.
+static void _interrupt(void)
+{
+    while (_irq_ready())
+    {
+        emu_stats.interrupts++;
+        _in_irq = 1;
+        BARRIER();
+        _busy = 0;
+        DMA1_Channel3_IRQHandler();
+        _busy = 1;
+        BARRIER();
+        _commit();
+        _in_irq = 0;
+    }
+}
+
+/// \brief Timer Signal
+/// \details Without a register access for a whole interval, the CPU is
+/// waiting for the DMA interrupt, run the SPI until the interrupt or until
+/// idle. A CPU that is still running keeps the SPI at its pace. Only with the
+/// transfer complete interrupt enabled, a polling driver stops circular
+/// transfers in time by itself.
+static void _timer(int sig)
+{
+    (void)sig;
+    uint32_t accesses = _accesses;
+    uint8_t  waiting  = accesses == _seen;
+    _seen             = accesses;
+    if (!waiting || _busy || _in_irq || !(_cfgr & DMA_CFGR1_TCIE))
+    {
+        return;
+    }
+
+    _busy = 1;
+    BARRIER();
+    _commit();
+    for (uint32_t i = 0; i < RUN_TICKS && _spi_busy() && !_irq_ready(); i++)
+    {
+        _tick();
+    }
+    _interrupt();
+    BARRIER();
+    _busy = 0;
+}
+
+void emu_sync(void)
+{
+    _accesses++;
+    _busy = 1;
+    BARRIER();
+    _commit();
+    _tick();
+    _interrupt();
+    BARRIER();
+    _busy = 0;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    if (irq == DMA1_Channel3_IRQn)
+    {
+        _irq_enabled = 1;
+    }
+    emu_sync();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+    emu_sync();
+    if (irq == DMA1_Channel3_IRQn)
+    {
+        _irq_enabled = 0;
+    }
+}
+
+void __enable_irq(void)
+{
+    _irq_global = 1;
+    emu_sync();
+}
+
+void __disable_irq(void)
+{
+    emu_sync();
+    _irq_global = 0;
+}
+
+void Delay_Ms(uint32_t n)
+{
+    (void)n;
+}
+
+void Delay_Us(uint32_t n)
+{
+    (void)n;
+}
+
+/// \brief DMA Interrupt of Drivers Built without ST7735_DMA_ASYNC
+__attribute__((weak)) void DMA1_Channel3_IRQHandler(void) {}
+
+/// \brief Reset the Chip and the Panel
+static void _reset(void)
+{
+    memset(&emu_gpioc, 0, sizeof(emu_gpioc));
+    memset(&emu_spi1, 0, sizeof(emu_spi1));
+    memset(&emu_dma1, 0, sizeof(emu_dma1));
+    memset(&emu_dma1_channel3, 0, sizeof(emu_dma1_channel3));
+    memset(&emu_rcc, 0, sizeof(emu_rcc));
+    emu_gpioc.CFGLR = 0x44444444;  // Floating inputs
+    emu_spi1.STATR  = SPI_STATR_TXE;
+    emu_spi1.DATAR  = DATAR_EMPTY;
+
+    _pins        = 0;
+    _ctlr1       = 0;
+    _cfgr        = 0;
+    _tx_full     = 0;
+    _shift_busy  = 0;
+    _dma_on      = 0;
+    _dma_left    = 0;
+    _dma_request = 0;
+    _irq_enabled = 0;
+    _irq_global  = 0;
+    _in_irq      = 0;
+
+    memset(_gram, 0, sizeof(_gram));
+    _panel_reset();
+    emu_reset_stats();
+    emu_violation = 0;
+}
+
+static ucontext_t _caller;
+static ucontext_t _context;
+static int (*_test)(void);
+static int     _result;
+static uint8_t _stack[STACK_SIZE] __attribute__((aligned(16)));
+
+static void _start(void)
+{
+    _result = _test();
+}
+
+int emu_run(int (*test)(void))
+{
+    if ((uintptr_t)(_stack + STACK_SIZE) > 0xFFFFFFFF)
+    {
+        fprintf(stderr, "emulator: memory is above 4 GB, link with -no-pie\n");
+        return 1;
+    }
+
+    _reset();
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _timer;
+    action.sa_flags   = SA_RESTART;
+    sigaction(SIGALRM, &action, 0);
+
+    struct itimerval timer = {{0, TIMER_US}, {0, TIMER_US}};
+    setitimer(ITIMER_REAL, &timer, 0);
+
+    _test = test;
+    getcontext(&_context);
+    _context.uc_stack.ss_sp   = _stack;
+    _context.uc_stack.ss_size = sizeof(_stack);
+    _context.uc_link          = &_caller;
+    makecontext(&_context, _start, 0);
+    swapcontext(&_caller, &_context);
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, 0);
+    return _result;
+}
+
+void emu_reset_stats(void)
+{
+    memset(&emu_stats, 0, sizeof(emu_stats));
+}
+
+void emu_flush(void)
+{
+    _busy = 1;
+    BARRIER();
+    _commit();
+    for (uint32_t i = 0; i < RUN_TICKS && (_spi_busy() || _irq_ready()); i++)
+    {
+        _tick();
+        _interrupt();
+    }
+    BARRIER();
+    _busy = 0;
+}
+
+uint16_t emu_width(void)
+{
+    return (_madctl & MADCTL_MV) ? VISIBLE_H : VISIBLE_W;
+}
+
+uint16_t emu_height(void)
+{
+    return (_madctl & MADCTL_MV) ? VISIBLE_W : VISIBLE_H;
+}
+
+uint16_t emu_pixel(int16_t x, int16_t y)
+{
+    // The location the driver writes (x, y) to, the panel line there shows a
+    // scrolled memory row.
+    uint16_t col, row;
+    if (_madctl & MADCTL_MV)
+    {
+        _locate(x + VISIBLE_Y0, y + VISIBLE_X0, &col, &row);
+    }
+    else
+    {
+        _locate(x + VISIBLE_X0, y + VISIBLE_Y0, &col, &row);
+    }
+
+    if (_scroll && _vsa && row >= _tfa && row < _tfa + _vsa)
+    {
+        int32_t n = (int32_t)row - _tfa + _ssa - _tfa;
+        row       = _tfa + ((n % _vsa) + _vsa) % _vsa;
+    }
+    uint16_t color = row < GRAM_ROWS ? _gram[row][col] : 0;
+    return (_invert ^ PANEL_INVERTED) ? ~color : color;
+}
+
+void emu_fill(uint16_t color)
+{
+    for (uint16_t row = 0; row < GRAM_ROWS; row++)
+    {
+        for (uint16_t col = 0; col < GRAM_COLS; col++)
+        {
+            _gram[row][col] = color;
+        }
+    }
+}
+
+uint32_t emu_hash(void)
+{
+    uint32_t hash = 2166136261u;
+    for (int16_t y = 0; y < emu_height(); y++)
+    {
+        for (int16_t x = 0; x < emu_width(); x++)
+        {
+            uint16_t color = emu_pixel(x, y);
+            hash           = (hash ^ (color >> 8)) * 16777619u;
+            hash           = (hash ^ (color & 0xFF)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+int emu_write_ppm(const char* path)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+    {
+        return 1;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", emu_width(), emu_height());
+    for (int16_t y = 0; y < emu_height(); y++)
+    {
+        for (int16_t x = 0; x < emu_width(); x++)
+        {
+            uint16_t color = emu_pixel(x, y);
+            uint8_t  r = color >> 11, g = (color >> 5) & 0x3F, b = color & 0x1F;
+            uint8_t  rgb[3] = {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+            fwrite(rgb, 1, sizeof(rgb), f);
+        }
+    }
+    return fclose(f) != 0;
+}
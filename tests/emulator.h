@@ -0,0 +1,92 @@
+/// \brief ST7735 Emulator for Host Builds of the Driver
+///
+/// \details st7735.c is compiled unchanged against the register model in
+/// ch32v003fun.h. The emulator shifts the SPI frames out, runs the DMA channel
+/// and its interrupt, and decodes the command stream into the memory of an
+/// 80x160 ST7735 panel with MADCTL, COLMOD, display inversion, the address
+/// window and vertical scrolling applied.
+///
+/// Time advances one tick per register access and a byte takes
+/// `emu_spi_ticks` ticks to shift out, so the CPU can run ahead of the SPI
+/// like on the chip. While the CPU waits for the DMA interrupt without
+/// accessing a register, a timer signal lets the transfer complete.
+///
+/// Tests run on a stack below 4 GB, started by emu_run(), so the 32-bit DMA
+/// address registers can hold pointers to stack buffers. Link with -no-pie.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#ifndef __EMULATOR_H__
+#define __EMULATOR_H__
+
+#include <stdint.h>
+
+/// \brief Wire Statistics
+typedef struct
+{
+    uint32_t bytes;          // Bytes received by the panel
+    uint32_t commands;       // Commands received
+    uint32_t windows;        // RAMWR commands, one per address window written
+    uint32_t caset;          // CASET commands
+    uint32_t raset;          // RASET commands
+    uint32_t pixels;         // Pixels written to memory
+    uint32_t hidden;         // Pixels written outside the visible area
+    uint32_t transactions;   // Rising edges of CS
+    uint32_t dma_transfers;  // DMA channel enables
+    uint32_t dma_chained;    // DMA channel enables by the interrupt handler
+    uint32_t interrupts;     // DMA interrupts taken
+    uint32_t violations;     // Errors of the driver, see emu_violation
+} emu_stats_t;
+
+extern emu_stats_t emu_stats;
+
+/// \brief First Error of the Driver
+/// \details DC or CS changed while data was still being sent, the SPI frame
+/// format changed while busy, a byte was written to a full transmit buffer
+/// or next to a running DMA transfer, or COLMOD selected a pixel format
+/// other than 16 bits. 0 if none.
+extern const char* emu_violation;
+
+/// \brief Ticks to Shift Out 8 Bits, 4 by Default
+extern uint16_t emu_spi_ticks;
+
+/// \brief Run a Test on the Emulator
+/// \param test Test function, returns the exit code.
+/// \return Exit code of the test, 1 if the emulator cannot start.
+/// \details Resets the emulator and runs the test on a stack below 4 GB.
+int emu_run(int (*test)(void));
+
+/// \brief Reset the Statistics
+void emu_reset_stats(void);
+
+/// \brief Run the SPI and DMA Until Idle
+/// \details Queued transfers are completed, their interrupts taken.
+void emu_flush(void);
+
+/// \brief Get the Screen Width in the Current Orientation
+uint16_t emu_width(void);
+
+/// \brief Get the Screen Height in the Current Orientation
+uint16_t emu_height(void);
+
+/// \brief Get a Pixel as Shown on the Screen
+/// \param x X, from the left of the screen in the current orientation
+/// \param y Y, from the top
+/// \return RGB565 color, with scrolling and display inversion applied.
+uint16_t emu_pixel(int16_t x, int16_t y);
+
+/// \brief Fill the Panel Memory
+/// \param color RGB565 color
+/// \details Sets every pixel, nothing is sent on the wire.
+void emu_fill(uint16_t color);
+
+/// \brief Hash the Screen
+/// \return FNV-1a hash of the pixels shown, row by row.
+uint32_t emu_hash(void);
+
+/// \brief Write the Screen to a PPM Image
+/// \param path File name
+/// \return 0 on success.
+int emu_write_ppm(const char* path);
+
+#endif  // __EMULATOR_H__
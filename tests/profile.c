@@ -0,0 +1,227 @@
+/// \brief Wire Profile of the Drawing Functions
+///
+/// \details Runs each drawing function on the emulator and prints what it
+/// sends per call: bytes, commands, address windows, pixels and DMA
+/// transfers, and a hash of the screen. The hash is a golden image: every
+/// driver build must draw the expected screen, or the profile fails. The
+/// vertical screen (ST7735_VERTICAL) has its own images. After an
+/// intended change of the pixels, check the images written with `-o DIR` to
+/// DIR/NAME.ppm and update the hashes.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <stdio.h>
+#include <string.h>
+
+#include "emulator.h"
+#include "st7735.h"
+
+/// \brief Profiled Function
+typedef struct
+{
+    const char* name;
+    uint16_t    calls;  // Calls of run
+    void (*run)(uint16_t i);
+    uint32_t hash;           // Expected screen hash
+    uint32_t hash_vertical;  // Expected screen hash of the vertical screen
+} profile_t;
+
+#ifdef ST7735_VERTICAL
+    #define PROFILE_HASH hash_vertical
+#else
+    #define PROFILE_HASH hash
+#endif
+
+static const uint8_t _tile[4 * 4 * 2] = {
+    0xF8, 0x00, 0xF8, 0x00, 0x00, 0x1F, 0x00, 0x1F,  //
+    0xF8, 0x00, 0xF8, 0x00, 0x00, 0x1F, 0x00, 0x1F,  //
+    0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF,  //
+    0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF,  //
+};
+
+static uint8_t _bitmap[16 * 16 * 2];
+
+static void _pixel(uint16_t i)
+{
+    tft_draw_pixel(i * 7 % ST7735_WIDTH, i * 13 % ST7735_HEIGHT, WHITE);
+}
+
+static void _line(uint16_t i)
+{
+    tft_draw_line(i, 0, ST7735_WIDTH - 1 - i, ST7735_HEIGHT - 1, YELLOW);
+}
+
+static void _line_h(uint16_t i)
+{
+    tft_draw_line(0, i, ST7735_WIDTH - 1, i, CYAN);
+}
+
+static void _line_aa(uint16_t i)
+{
+    tft_draw_line_aa(i, 0, ST7735_WIDTH - 1 - i, ST7735_HEIGHT - 1, WHITE, BLACK);
+}
+
+static void _rect(uint16_t i)
+{
+    tft_draw_rect(10 + i, 10 + i, 40, 30, GREEN);
+}
+
+static void _fill_rect(uint16_t i)
+{
+    tft_fill_rect(10 + i, 10 + i, 40, 30, RED);
+}
+
+static void _round_rect(uint16_t i)
+{
+    tft_fill_round_rect(10 + i, 10 + i, 40, 30, 6, BLUE);
+}
+
+static void _circle(uint16_t i)
+{
+    tft_draw_circle(40 + i, 40, 20, MAGENTA);
+}
+
+static void _fill_circle(uint16_t i)
+{
+    tft_fill_circle(40 + i, 40, 20, ORANGE);
+}
+
+static void _triangle(uint16_t i)
+{
+    tft_fill_triangle(10 + i, 70, 40 + i, 5, 70 + i, 60, PINK);
+}
+
+static void _gradient(uint16_t i)
+{
+    tft_fill_gradient_h(i, 10, 60, 40, RED, BLUE, 1);
+}
+
+static void _bitmap16(uint16_t i)
+{
+    tft_draw_bitmap(i * 16 % ST7735_WIDTH, 20, 16, 16, _bitmap);
+}
+
+static void _pattern(uint16_t i)
+{
+    tft_fill_pattern(i, 10, 50, 30, _tile, 4, 4);
+}
+
+static void _print(uint16_t i)
+{
+    tft_set_cursor(0, i * 8 % ST7735_HEIGHT);
+    tft_print("Hello, World!");
+}
+
+static void _print_2x(uint16_t i)
+{
+    tft_set_text_size(2);
+    tft_set_cursor(0, i * 16 % ST7735_HEIGHT);
+    tft_print("Hello!");
+    tft_set_text_size(1);
+}
+
+static void _print_box(uint16_t i)
+{
+    tft_print_box(i, 10, 88, 17, "Hello, World!", TEXT_ALIGN_CENTER | TEXT_ALIGN_MIDDLE);
+}
+
+static void _printf(uint16_t i)
+{
+    tft_set_cursor(0, i * 8 % ST7735_HEIGHT);
+    tft_printf("x=%d y=%d", i, -i);
+}
+
+static const profile_t _profiles[] = {
+    {"pixel", 100, _pixel, 0x7755C83D, 0xA7505D3D},
+    {"line", 10, _line, 0xC9BC9135, 0xCF114675},
+    {"line_h", 10, _line_h, 0x26ACAC45, 0xA03DE805},
+    {"line_aa", 10, _line_aa, 0xF5298E85, 0x693E9292},
+    {"rect", 10, _rect, 0xA0604DD5, 0x7F28C1D5},
+    {"fill_rect", 10, _fill_rect, 0x95E5CD1D, 0x791BC41D},
+    {"fill_round_rect", 10, _round_rect, 0x18407AF0, 0xE16D0470},
+    {"circle", 10, _circle, 0x201245C5, 0x2639C1C5},
+    {"fill_circle", 10, _fill_circle, 0x036D67FD, 0x01A30DFD},
+    {"fill_triangle", 10, _triangle, 0x59BC6871, 0x2C0F0C71},
+    {"gradient_h", 10, _gradient, 0xC84C0B45, 0x7485D945},
+    {"bitmap_16x16", 10, _bitmap16, 0x2B4DF5C5, 0xF03BB3C5},
+    {"fill_pattern", 10, _pattern, 0xCC742265, 0x4AE870E5},
+    {"print", 10, _print, 0x8F880EFD, 0xCD97D4FD},
+    {"print_2x", 10, _print_2x, 0x959175BD, 0xBB9665B5},
+    {"print_box", 10, _print_box, 0x6BF35671, 0xB1409E2D},
+    {"printf", 10, _printf, 0xCA7E9607, 0x75517F07},
+};
+
+static const char* _dir = 0;
+
+static int _profile(void)
+{
+    int result = 0;
+
+    for (uint16_t i = 0; i < sizeof(_bitmap); i++)
+    {
+        _bitmap[i] = i * 37;
+    }
+
+    tft_init();
+    tft_set_color(WHITE);
+    tft_set_background_color(BLACK);
+
+    printf("%-16s %8s %8s %8s %8s %8s %8s\n", "per call", "bytes", "commands", "windows", "pixels", "dma", "screen");
+    for (uint8_t p = 0; p < sizeof(_profiles) / sizeof(_profiles[0]); p++)
+    {
+        const profile_t* profile = &_profiles[p];
+
+        tft_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, BLACK);
+        tft_wait();
+        emu_flush();
+        emu_reset_stats();
+
+        for (uint16_t i = 0; i < profile->calls; i++)
+        {
+            profile->run(i);
+        }
+        tft_wait();
+        emu_flush();
+
+        printf("%-16s %8.1f %8.1f %8.1f %8.1f %8.1f %08x\n", profile->name,
+               (double)emu_stats.bytes / profile->calls, (double)emu_stats.commands / profile->calls,
+               (double)emu_stats.windows / profile->calls, (double)emu_stats.pixels / profile->calls,
+               (double)emu_stats.dma_transfers / profile->calls, emu_hash());
+
+        if (emu_stats.violations)
+        {
+            printf("%s: %s\n", profile->name, emu_violation);
+            return 1;
+        }
+        if (emu_hash() != profile->PROFILE_HASH)
+        {
+            printf("%s: screen %08x, expected %08x\n", profile->name, emu_hash(), profile->PROFILE_HASH);
+            result = 1;
+        }
+        if (_dir)
+        {
+            char path[256];
+            snprintf(path, sizeof(path), "%s/%s.ppm", _dir, profile->name);
+            if (emu_write_ppm(path))
+            {
+                printf("%s: cannot write\n", path);
+                return 1;
+            }
+        }
+    }
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 3 && !strcmp(argv[1], "-o"))
+    {
+        _dir = argv[2];
+    }
+    else if (argc != 1)
+    {
+        printf("Usage: %s [-o DIR]\n", argv[0]);
+        return 1;
+    }
+    return emu_run(_profile);
+}
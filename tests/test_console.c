@@ -0,0 +1,207 @@
+/// \brief Test of the Text Console
+///
+/// \details Lines of random text, most runs more than fit, are printed to the
+/// console in the built-in font at 1x and 3x and in the proportional font of
+/// test_font.bdf at 1x and 2x, separated by '\n' in the text, by
+/// tft_console_putc() and by tft_console_newline(). The reference prints each
+/// line with tft_print() over the background, one character at a time where
+/// the console gets one character at a time:
+///
+/// - On a vertical screen (ST7735_VERTICAL) the console scrolls in hardware
+///   and shows the last lines from the top down. A newline at the bottom must
+///   send only the scroll start address and the cleared line.
+/// - On a horizontal screen the console wraps to the top line, each line
+///   replaces the one printed a screen earlier. A newline at the bottom must
+///   send only the cleared line.
+///
+/// Above the bottom, a newline sends nothing. After tft_console_end() memory
+/// rows are shown unscrolled, where both orientations keep line i at line
+/// i % lines of the console. Once the horizontal console has wrapped, every
+/// new line is cleared.
+///
+/// The font header is generated from the BDF fixture by tools/bdf2font.py.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <string.h>
+
+#include "check.h"
+#include "font_test.h"
+
+#define RUNS 60
+
+static screen_t _ref_last;     // All lines printed
+static screen_t _ref_newline;  // And a newline
+static screen_t _ref_end;      // And one more line, after tft_console_end()
+
+static char _lines[100][32];
+
+static const char     _chars[] = "AWojx0123456789-. |";
+static const uint16_t _colors[] = {WHITE, BLACK, RED, GREEN, BLUE, YELLOW, CYAN, NAVY, ORANGE};
+
+#ifdef ST7735_VERTICAL
+    #define SCROLL_COMMANDS 1  // VSCSAD
+    #define WRAPPED         0  // The console scrolls
+#else
+    #define SCROLL_COMMANDS 0
+    #define WRAPPED         1
+#endif
+
+/// \brief Print the Text of a Line
+/// \param i Line
+/// \param console To the console, else with tft_print()
+/// \details Every third line is sent one character at a time.
+static void _print_line(uint16_t i, uint8_t console)
+{
+    if (i % 3 || !i)
+    {
+        if (console)
+        {
+            tft_console_print(_lines[i]);
+        }
+        else
+        {
+            tft_print(_lines[i]);
+        }
+        return;
+    }
+    for (const char* c = _lines[i]; *c; c++)
+    {
+        char str[2] = {*c, '\0'};
+        if (console)
+        {
+            tft_console_putc(*c);
+        }
+        else
+        {
+            tft_print(str);
+        }
+    }
+}
+
+/// \brief Reference Console
+/// \param ref Reference screen
+/// \param n Number of lines printed, _lines[0] to _lines[n - 1]
+/// \param lines Lines of the console
+/// \param line_h Height of a line
+/// \param bg Background color
+/// \param wrapped Line i at line i % lines, else the last lines from the top
+/// down.
+static void _ref_console(screen_t ref, uint16_t n, uint8_t lines, int16_t line_h, uint16_t bg, uint8_t wrapped)
+{
+    uint16_t first = n > lines ? n - lines : 0;
+
+    check_clear(ref, bg);
+    for (uint16_t i = first; i < n; i++)
+    {
+        tft_set_cursor(0, (wrapped ? i % lines : i - first) * line_h);
+        _print_line(i, 0);
+    }
+    tft_wait();
+    emu_flush();
+    check_save(ref);
+}
+
+/// \brief Random Line Fitting the Screen
+static void _random_line(char* str)
+{
+    uint8_t len = check_random(0, 30);
+    for (uint8_t i = 0; i < len; i++)
+    {
+        str[i] = _chars[check_random(0, sizeof(_chars) - 2)];
+    }
+    str[len] = '\0';
+
+    uint16_t w, h;
+    for (tft_text_extent(str, &w, &h); w > ST7735_WIDTH; tft_text_extent(str, &w, &h))
+    {
+        str[--len] = '\0';
+    }
+}
+
+static int _test(void)
+{
+    tft_init();
+    tft_set_transparent(0);
+
+    for (uint16_t run = 0; run < RUNS; run++)
+    {
+        const font_t* font = (run & 2) ? &font_test : 0;
+        uint8_t       size = (run & 2) ? 1 + (run & 1) : 1 + 2 * (run & 1);
+        int16_t       line_h = (font ? font->height : 8) * size;
+        uint8_t       lines  = ST7735_HEIGHT / line_h;
+        uint16_t      n      = check_random(1, 3 * lines);
+        uint16_t      bg     = _colors[check_random(0, 8)];
+
+        tft_set_font(font);
+        tft_set_text_size(size);
+        tft_set_color(_colors[check_random(0, 8)]);
+        tft_set_background_color(bg);
+        for (uint16_t i = 0; i < n; i++)
+        {
+            _random_line(_lines[i]);
+        }
+        _ref_console(_ref_last, n, lines, line_h, bg, WRAPPED);
+        _lines[n][0] = '\0';
+        _ref_console(_ref_newline, n + 1, lines, line_h, bg, WRAPPED);
+        _random_line(_lines[n]);
+        _ref_console(_ref_end, n + 1, lines, line_h, bg, 1);
+
+        // The console clears the whole screen
+        emu_fill(MAGENTA);
+        tft_console_begin();
+        for (uint16_t i = 0; i < n; i++)
+        {
+            if (i % 3 == 2)
+            {
+                char str[40];
+                snprintf(str, sizeof(str), "\n%s", _lines[i]);
+                tft_console_print(str);
+                continue;
+            }
+            if (i)
+            {
+                if (i % 3)
+                {
+                    tft_console_newline();
+                }
+                else
+                {
+                    tft_console_putc('\n');
+                }
+            }
+            _print_line(i, 1);
+        }
+
+        char what[80];
+        snprintf(what, sizeof(what), "%d lines of %d in %s %dx", n, lines, font ? "font" : "5x7", size);
+        CHECK(check_screen(_ref_last, what) == 0);
+
+        // Only the new line is cleared, and scrolled in
+        emu_reset_stats();
+        tft_console_newline();
+        CHECK(check_screen(_ref_newline, what) == 0);
+        if (n >= lines)
+        {
+            CHECK(emu_stats.windows == 1);
+            CHECK(emu_stats.commands == SCROLL_COMMANDS + emu_stats.caset + emu_stats.raset + emu_stats.windows);
+            CHECK(emu_stats.pixels == (uint32_t)ST7735_WIDTH * line_h);
+        }
+        else
+        {
+            CHECK(emu_stats.commands == 0);
+        }
+
+        _print_line(n, 1);
+        tft_console_end();
+        CHECK(check_screen(_ref_end, what) == 0);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
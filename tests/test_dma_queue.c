@@ -0,0 +1,151 @@
+/// \brief Test of the Background DMA Transfer Queue
+///
+/// \details Built with ST7735_DMA_ASYNC. The SPI is slowed down so the
+/// drawing functions return long before their data is sent. Checks that:
+///  - the functions return while the transfers are still running,
+///  - the interrupt handler takes every transfer and chains the queued ones,
+///  - the transfers drain in the order they were queued, overlapping
+///    drawings end up as drawn by a reference on the host,
+///  - DC and CS only change after the last byte has left the shift register,
+///    and tft_wait() returns after that byte.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#ifndef ST7735_DMA_ASYNC
+    #error Build with ST7735_DMA_ASYNC
+#endif
+
+// Screen as drawn by the reference
+static screen_t _ref;
+
+// Sources must stay valid until the transfers are done
+#define BITMAPS 8
+static uint8_t _bitmaps[BITMAPS][12 * 12 * 2];
+static uint8_t _tile[16 * 16 * 2];
+
+static void _ref_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT)
+    {
+        _ref[y][x] = color;
+    }
+}
+
+static void _ref_fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    for (int16_t j = 0; j < height; j++)
+    {
+        for (int16_t i = 0; i < width; i++)
+        {
+            _ref_pixel(x + i, y + j, color);
+        }
+    }
+}
+
+/// \brief Reference of a Bitmap Tiled over an Area
+static void _ref_pattern(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* tile, uint16_t tw, uint16_t th)
+{
+    for (int16_t j = 0; j < height; j++)
+    {
+        for (int16_t i = 0; i < width; i++)
+        {
+            const uint8_t* p = tile + (((j % th) * tw + i % tw) << 1);
+            _ref_pixel(x + i, y + j, p[0] << 8 | p[1]);
+        }
+    }
+}
+
+static void _fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    tft_fill_rect(x, y, width, height, color);
+    _ref_fill_rect(x, y, width, height, color);
+}
+
+static void _draw_bitmap(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* bitmap)
+{
+    tft_draw_bitmap(x, y, width, height, bitmap);
+    _ref_pattern(x, y, width, height, bitmap, width, height);
+}
+
+static void _fill_pattern(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t* tile, uint16_t tw, uint16_t th)
+{
+    tft_fill_pattern(x, y, width, height, tile, tw, th);
+    _ref_pattern(x, y, width, height, tile, tw, th);
+}
+
+/// \brief Check That the Wire Is Idle Once tft_wait() Returns
+static void _wait(void)
+{
+    tft_wait();
+    CHECK(!tft_busy());
+
+    uint32_t bytes = emu_stats.bytes;
+    emu_flush();
+    CHECK(emu_stats.bytes == bytes);
+}
+
+static int _test(void)
+{
+    for (uint16_t b = 0; b < BITMAPS; b++)
+    {
+        for (uint16_t i = 0; i < sizeof(_bitmaps[b]); i++)
+        {
+            _bitmaps[b][i] = (b + 1) * 29 + i * 7;
+        }
+    }
+    for (uint16_t i = 0; i < sizeof(_tile); i++)
+    {
+        _tile[i] = i * 13 + (i >> 5);
+    }
+
+    tft_init();
+    _fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, BLACK);
+    _wait();
+
+    emu_spi_ticks = 64;  // Slow SPI, the CPU runs far ahead
+    emu_reset_stats();
+
+    // Overlapping bitmaps, more than the queue holds. Each one covers part of
+    // the previous, a transfer sent out of order leaves a wrong overlap.
+    for (uint16_t b = 0; b < BITMAPS; b++)
+    {
+        _draw_bitmap(4 + b * 5, 4 + b * 3, 12, 12, _bitmaps[b]);
+        CHECK(tft_busy());
+    }
+
+    // Fill mode after buffer mode, over the bitmaps
+    _fill_rect(20, 10, 30, 8, RED);
+    CHECK(tft_busy());
+
+    // Head, whole rows and tail of a large tile, one window for the area
+    _fill_pattern(-5, 30, 70, 30, _tile, 16, 16);
+    CHECK(tft_busy());
+
+    // Buffer mode again, then fill mode with a bitmap on top
+    _draw_bitmap(60, 40, 12, 12, _bitmaps[0]);
+    _fill_rect(66, 46, 40, 20, GREEN);
+    _draw_bitmap(100, 50, 12, 12, _bitmaps[1]);
+    CHECK(tft_busy());
+
+    _wait();
+
+    printf("%u transfers, %u chained by the interrupt, %u interrupts, %u bytes\n", emu_stats.dma_transfers,
+           emu_stats.dma_chained, emu_stats.interrupts, emu_stats.bytes);
+    CHECK(emu_stats.interrupts == emu_stats.dma_transfers);
+    CHECK(emu_stats.dma_chained > 0);
+    CHECK(emu_stats.violations == 0);
+    if (emu_violation)
+    {
+        printf("violation: %s\n", emu_violation);
+    }
+    CHECK(check_mismatches(_ref, "queue") == 0);
+
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,153 @@
+/// \brief Test of the Circle and Ellipse Primitives
+///
+/// \details Random circles and ellipses, many of them partly off the screen,
+/// are compared with a per-pixel reference of the textbook midpoint
+/// algorithm. Its decisions are kept exact by scaling them by 4. Outlines
+/// plot the four mirrored points of each step, fills span the rows between
+/// them. Every visible pixel of a shape must be written exactly once.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#define SHAPES 600
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels set by the reference
+
+static void _ref_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT && _ref[y][x] != color)
+    {
+        _ref[y][x] = color;
+        _ref_pixels++;
+    }
+}
+
+/// \brief Reference Ellipse, One Pixel at a Time
+static void _ref_ellipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint8_t fill, uint16_t color)
+{
+    int16_t span[256];  // Widest x on each row from the center
+    for (int16_t j = 0; j <= ry; j++)
+    {
+        span[j] = -1;
+    }
+
+    if (rx == 0 || ry == 0)
+    {
+        for (int16_t j = 0; j <= ry; j++)
+        {
+            span[j] = rx;
+        }
+        fill = 1;
+    }
+    else
+    {
+        int64_t rx2 = (int64_t)rx * rx, ry2 = (int64_t)ry * ry;
+        int64_t x = 0, y = ry;
+        int64_t d = 4 * ry2 - 4 * rx2 * ry + rx2;  // 4 times the decision
+        while (2 * ry2 * x < 2 * rx2 * y)
+        {
+            span[y] = x > span[y] ? x : span[y];
+            if (!fill)
+            {
+                _ref_pixel(x0 - x, y0 - y, color);
+                _ref_pixel(x0 + x, y0 - y, color);
+                _ref_pixel(x0 - x, y0 + y, color);
+                _ref_pixel(x0 + x, y0 + y, color);
+            }
+            x++;
+            if (d < 0)
+            {
+                d += 4 * (2 * ry2 * x + ry2);
+            }
+            else
+            {
+                y--;
+                d += 4 * (2 * ry2 * x - 2 * rx2 * y + ry2);
+            }
+        }
+        d = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * (y - 1) * (y - 1) - 4 * rx2 * ry2;
+        while (y >= 0)
+        {
+            span[y] = x > span[y] ? x : span[y];
+            if (!fill)
+            {
+                _ref_pixel(x0 - x, y0 - y, color);
+                _ref_pixel(x0 + x, y0 - y, color);
+                _ref_pixel(x0 - x, y0 + y, color);
+                _ref_pixel(x0 + x, y0 + y, color);
+            }
+            y--;
+            if (d > 0)
+            {
+                d += 4 * (rx2 - 2 * rx2 * y);
+            }
+            else
+            {
+                x++;
+                d += 4 * (2 * ry2 * x - 2 * rx2 * y + rx2);
+            }
+        }
+    }
+
+    if (fill)
+    {
+        for (int16_t j = 0; j <= ry; j++)
+        {
+            for (int16_t i = -span[j]; i <= span[j]; i++)
+            {
+                _ref_pixel(x0 + i, y0 - j, color);
+                _ref_pixel(x0 + i, y0 + j, color);
+            }
+        }
+    }
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < SHAPES; n++)
+    {
+        int16_t  x     = check_random(-30, ST7735_WIDTH + 30);
+        int16_t  y     = check_random(-30, ST7735_HEIGHT + 30);
+        int16_t  rx    = check_random(0, n < 20 ? 3 : 70);
+        int16_t  ry    = n & 1 ? rx : check_random(0, n < 20 ? 3 : 70);
+        uint8_t  fill  = (n >> 1) & 1;
+        uint16_t color = n & 4 ? WHITE : ORANGE;
+
+        check_clear(_ref, BLACK);
+        _ref_pixels = 0;
+        _ref_ellipse(x, y, rx, ry, fill, color);
+        if (fill)
+        {
+            tft_fill_ellipse(x, y, rx, ry, color);
+        }
+        else
+        {
+            tft_draw_ellipse(x, y, rx, ry, color);
+        }
+
+        char what[80];
+        snprintf(what, sizeof(what), "%s (%d, %d) %dx%d", fill ? "fill" : "draw", x, y, rx, ry);
+        CHECK(check_screen(_ref, what) == 0);
+        CHECK(emu_stats.pixels == _ref_pixels);
+    }
+
+    // Circles are ellipses with equal radii
+    check_clear(_ref, BLACK);
+    _ref_ellipse(40, 40, 30, 30, 0, WHITE);
+    tft_draw_circle(40, 40, 30, WHITE);
+    _ref_ellipse(120, 40, 25, 25, 1, RED);
+    tft_fill_circle(120, 40, 25, RED);
+    CHECK(check_screen(_ref, "circles") == 0);
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
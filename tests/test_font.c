@@ -0,0 +1,264 @@
+/// \brief Test of the Proportional Fonts
+///
+/// \details Random strings of the glyphs of test_font.bdf, a descender left
+/// of the cursor, a glyph wider than its advance and a rule of 100 pixels
+/// among them, are printed at 1x and 2x, with and without a background,
+/// many of them partly off the screen. The reference draws them one pixel at
+/// a time:
+///
+/// - With a background, the line is cut into chunks of whole characters of
+///   at most ST7735_WIDTH pixels, a single wider character is cut to that
+///   width. Each chunk is a box of the background color, glyph pixels
+///   outside it are dropped. Every visible pixel of the box is written once,
+///   whatever the bands of rows sent.
+/// - Transparent, pixels of at least half coverage are drawn in the text
+///   color, glyphs may overlap.
+///
+/// The fixture is also shrunk 2 times into a 2bpp font and 4 times into a
+/// 4bpp one. Their pixels must be the blends of the text color and the
+/// background documented for the driver table, which must also be rebuilt
+/// when only the background color changes.
+///
+/// The font headers are generated from the BDF fixture by tools/bdf2font.py.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <string.h>
+
+#include "check.h"
+#include "font_test.h"
+#include "font_test_2bpp.h"
+#include "font_test_4bpp.h"
+
+#define STRINGS 800
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels written by the reference
+static uint16_t _lut[16];     // Blends of the reference, levels 0 to 15
+
+static const font_t* _fonts[] = {&font_test, &font_test_2bpp, &font_test_4bpp};
+
+static const char     _chars[] = "AWojx|._ Q";  // Q has no glyph
+static const uint16_t _colors[] = {WHITE, BLACK, RED, GREEN, BLUE, YELLOW, CYAN, NAVY, ORANGE, PINK, DARKGREY};
+
+/// \brief Reference Blends, Accumulated in 17 / 256 Steps of a Channel
+static void _ref_lut(uint16_t color, uint16_t bg)
+{
+    int16_t r = bg >> 11, g = (bg >> 5) & 0x3F, b = bg & 0x1F;
+    int16_t dr = (color >> 11) - r, dg = ((color >> 5) & 0x3F) - g, db = (color & 0x1F) - b;
+    for (int16_t i = 0; i < 16; i++)
+    {
+        _lut[i] = ((r + ((17 * dr * i + 128) >> 8)) << 11) | ((g + ((17 * dg * i + 128) >> 8)) << 5) |
+                  (b + ((17 * db * i + 128) >> 8));
+    }
+}
+
+/// \brief Coverage of a Glyph Pixel, 0 to 15
+static uint8_t _ref_level(const font_t* font, const glyph_t* g, int16_t i, int16_t j)
+{
+    uint8_t  bpp = font->bpp > 1 ? font->bpp : 1;
+    uint16_t bit = (i * g->width + j) * bpp;
+    uint8_t  v   = (font->bitmap[g->offset + (bit >> 3)] >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1);
+    return v * (bpp == 1 ? 15 : bpp == 2 ? 5 : 1);
+}
+
+static const glyph_t* _ref_glyph(const font_t* font, char c)
+{
+    uint8_t code = c;
+    return (code < font->first || code > font->last) ? 0 : &font->glyphs[code - font->first];
+}
+
+static void _ref_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT)
+    {
+        _ref[y][x] = color;
+        _ref_pixels++;
+    }
+}
+
+/// \brief Reference Print
+/// \param x Cursor X coordinate, moved past the string.
+static void _ref_print(const font_t* font, const char* str, int16_t* x, int16_t y, uint8_t s, uint8_t transparent,
+                       uint16_t color, uint16_t bg)
+{
+    uint16_t len = strlen(str);
+
+    if (transparent)
+    {
+        for (uint16_t k = 0; k < len; k++)
+        {
+            const glyph_t* g = _ref_glyph(font, str[k]);
+            if (!g)
+            {
+                continue;
+            }
+            for (int16_t i = 0; i < g->height; i++)
+            {
+                for (int16_t j = 0; j < g->width; j++)
+                {
+                    if (_ref_level(font, g, i, j) >= 8)
+                    {
+                        for (int16_t t = 0; t < s * s; t++)
+                        {
+                            _ref_pixel(*x + (g->x_offset + j) * s + t % s, y + (g->y_offset + i) * s + t / s, color);
+                        }
+                    }
+                }
+            }
+            *x += g->advance * s;
+        }
+        return;
+    }
+
+    static uint16_t box[16 * 5][ST7735_WIDTH];
+    int16_t         h = font->height * s;
+    while (len)
+    {
+        // Chunk of whole characters
+        uint16_t n = 0;
+        int16_t  w = 0, advance = 0;
+        while (n < len)
+        {
+            const glyph_t* g = _ref_glyph(font, str[n]);
+            advance          = g ? g->advance * s : 0;
+            if (w + advance > ST7735_WIDTH)
+            {
+                break;
+            }
+            w += advance;
+            n++;
+        }
+        int16_t next = *x + w;
+        if (!n)
+        {
+            n    = 1;
+            w    = ST7735_WIDTH;
+            next = *x + advance;
+        }
+
+        for (int16_t r = 0; r < h; r++)
+        {
+            for (int16_t c = 0; c < w; c++)
+            {
+                box[r][c] = bg;
+            }
+        }
+        int16_t cell = 0;
+        for (uint16_t k = 0; k < n; k++)
+        {
+            const glyph_t* g = _ref_glyph(font, str[k]);
+            if (!g)
+            {
+                continue;
+            }
+            for (int16_t i = 0; i < g->height; i++)
+            {
+                for (int16_t j = 0; j < g->width; j++)
+                {
+                    uint8_t level = _ref_level(font, g, i, j);
+                    for (int16_t t = 0; level && t < s * s; t++)
+                    {
+                        int16_t c = cell + (g->x_offset + j) * s + t % s;
+                        int16_t r = (g->y_offset + i) * s + t / s;
+                        if (c >= 0 && c < w && r >= 0 && r < h)
+                        {
+                            box[r][c] = _lut[level];
+                        }
+                    }
+                }
+            }
+            cell += g->advance * s;
+        }
+        for (int16_t r = 0; r < h; r++)
+        {
+            for (int16_t c = 0; c < w; c++)
+            {
+                _ref_pixel(*x + c, y + r, box[r][c]);
+            }
+        }
+
+        *x = next;
+        str += n;
+        len -= n;
+    }
+}
+
+/// \brief Print a String with the Driver and the Reference
+static void _check(const font_t* font, const char* str, int16_t x, int16_t y, uint8_t s, uint8_t transparent,
+                   uint16_t color, uint16_t bg, uint8_t split)
+{
+    char first[40];
+    strcpy(first, str);
+    first[split] = '\0';
+
+    check_clear(_ref, MAGENTA);
+    _ref_pixels = 0;
+    _ref_lut(color, bg);
+    int16_t rx = x;
+    _ref_print(font, first, &rx, y, s, transparent, color, bg);
+    _ref_print(font, str + split, &rx, y, s, transparent, color, bg);
+
+    tft_set_font(font);
+    tft_set_text_size(s);
+    tft_set_transparent(transparent);
+    tft_set_color(color);
+    tft_set_background_color(bg);
+    tft_set_cursor(x, y);
+    tft_print(first);
+    tft_print(str + split);
+
+    char what[100];
+    snprintf(what, sizeof(what), "\"%s\" split %d at (%d, %d) %dx %s, %d bpp", str, split, x, y, s,
+             transparent ? "transparent" : "opaque", font->bpp);
+    CHECK(check_screen(_ref, what) == 0);
+    CHECK(emu_stats.pixels == _ref_pixels);
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint8_t f = 0; f < sizeof(_fonts) / sizeof(_fonts[0]); f++)
+    {
+        const font_t* font = _fonts[f];
+
+        // Rules wider than the buffer: chunks at 1x, cut at 2x
+        _check(font, "A__W", 10, 20, 1, 0, WHITE, BLUE, 0);
+        _check(font, "A_W", -30, 20, 2, 0, WHITE, BLUE, 0);
+        _check(font, "_x_", -150, 40, 2, 1, WHITE, BLUE, 1);
+
+        // Descender left of the cursor and of the screen
+        _check(font, "jojx", 0, 0, 1, 0, YELLOW, NAVY, 0);
+        _check(font, "jojx", 1, 70, 2, 1, YELLOW, NAVY, 2);
+
+        // Only the background changes, the blends must follow
+        _check(font, "AWoxAWox", 4, 10, 2, 0, WHITE, BLUE, 0);
+        _check(font, "AWoxAWox", 4, 10, 2, 0, WHITE, RED, 0);
+        _check(font, "AWoxAWox", 4, 10, 2, 0, ORANGE, RED, 0);
+
+        for (uint16_t n = 0; n < STRINGS; n++)
+        {
+            char    str[32];
+            uint8_t len = check_random(1, 30);
+            for (uint8_t i = 0; i < len; i++)
+            {
+                str[i] = _chars[check_random(0, sizeof(_chars) - 2)];
+            }
+            str[len] = '\0';
+
+            uint8_t  s = check_random(1, 2);
+            int16_t  x = check_random(-150, ST7735_WIDTH), y = check_random(-16 * s, ST7735_HEIGHT);
+            uint16_t color = _colors[check_random(0, 10)], bg = _colors[check_random(0, 10)];
+            _check(font, str, x, y, s, n & 1, color, bg, check_random(0, len));
+        }
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,102 @@
+/// \brief Test of the Gradient Fills
+///
+/// \details Random horizontal and vertical gradients, many of them partly off
+/// the screen, are compared with the exact blend of each channel along the
+/// gradient. Without dither a channel must be within half a step of it, with
+/// dither within one step. Every row of a horizontal gradient is the same,
+/// every row of a vertical one is solid, and each visible pixel is written
+/// once. Pixels around the rectangle are left alone.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <math.h>
+
+#include "check.h"
+
+#define GRADIENTS 1000
+
+static screen_t _ref;
+
+/// \brief Check a Channel Against the Exact Blend
+/// \param value Channel of the pixel
+/// \param c0 Channel of the first color
+/// \param c1 Channel of the last color
+/// \param i Step along the gradient
+/// \param n Number of steps
+/// \param error Largest error allowed, in channel steps
+static uint8_t _channel_ok(int16_t value, int16_t c0, int16_t c1, int16_t i, int16_t n, double error)
+{
+    double exact = (n > 1) ? c0 + (double)(c1 - c0) * i / (n - 1) : c0;
+    return fabs(value - exact) <= error;
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < GRADIENTS; n++)
+    {
+        int16_t  x = check_random(-40, ST7735_WIDTH), y = check_random(-40, ST7735_HEIGHT);
+        int16_t  w = check_random(1, 200), h = check_random(1, 120);
+        uint16_t c0 = check_random(0, 0xFFFF), c1 = check_random(0, 0xFFFF);
+        uint8_t  dither   = n & 1;
+        uint8_t  vertical = (n >> 1) & 1;
+        if (n % 16 < 4)
+        {
+            c1 = c0;  // Solid
+        }
+
+        check_clear(_ref, MAGENTA);
+        if (vertical)
+        {
+            tft_fill_gradient_v(x, y, w, h, c0, c1, dither);
+        }
+        else
+        {
+            tft_fill_gradient_h(x, y, w, h, c0, c1, dither);
+        }
+        tft_wait();
+        emu_flush();
+
+        // Visible part of the rectangle
+        int16_t  x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+        int16_t  x1 = x + w > ST7735_WIDTH ? ST7735_WIDTH : x + w;
+        int16_t  y1 = y + h > ST7735_HEIGHT ? ST7735_HEIGHT : y + h;
+        uint32_t visible = (x1 > x0 && y1 > y0) ? (uint32_t)(x1 - x0) * (y1 - y0) : 0;
+        double   error   = dither ? 0.999 : 0.5 + 1.0 / 256;  // 16.16 steps lose < 1/65536 each
+
+        uint32_t errors = 0;
+        for (int16_t py = 0; py < ST7735_HEIGHT; py++)
+        {
+            for (int16_t px = 0; px < ST7735_WIDTH; px++)
+            {
+                uint16_t p  = emu_pixel(px, py);
+                uint8_t  ok = p == MAGENTA;
+                if (px >= x0 && px < x1 && py >= y0 && py < y1)
+                {
+                    int16_t i     = vertical ? py - y : px - x;
+                    int16_t steps = vertical ? h : w;
+                    ok = _channel_ok(p >> 11, c0 >> 11, c1 >> 11, i, steps, error) &&
+                         _channel_ok((p >> 5) & 0x3F, (c0 >> 5) & 0x3F, (c1 >> 5) & 0x3F, i, steps, error) &&
+                         _channel_ok(p & 0x1F, c0 & 0x1F, c1 & 0x1F, i, steps, error) &&
+                         p == (vertical ? emu_pixel(x0, py) : emu_pixel(px, y0));
+                }
+                if (!ok && !errors++)
+                {
+                    printf("%s%s (%d, %d) %dx%d %04x - %04x: (%d, %d) is %04x\n", vertical ? "vertical" : "horizontal",
+                           dither ? " dithered" : "", x, y, w, h, c0, c1, px, py, p);
+                }
+            }
+        }
+        CHECK(errors == 0);
+        CHECK(emu_stats.pixels == visible);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
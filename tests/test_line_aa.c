@@ -0,0 +1,145 @@
+/// \brief Test of the Anti-Aliased Lines
+///
+/// \details Random lines, many of them partly off the screen, are drawn over
+/// their background color and compared with Wu's algorithm in floating
+/// point. On each step along the major axis, the pixel at the exact minor
+/// coordinate and its neighbour share the coverage. Every channel of a pixel
+/// must lie between the blends one level below and one level above its exact
+/// coverage, 1 LSB of rounding allowed, and pixels off the line keep the
+/// background.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "check.h"
+
+#define LINES  2000
+#define LEVELS 8  // AA_LEVELS of the driver
+
+static const uint16_t _colors[] = {WHITE, BLACK, RED, GREEN, BLUE, YELLOW, CYAN, NAVY, ORANGE, PINK, DARKGREY};
+
+static float _coverage[ST7735_HEIGHT][ST7735_WIDTH];  // Exact coverage, 0 - 1
+
+static void _ref_pixel(int16_t x, int16_t y, float coverage)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT)
+    {
+        _coverage[y][x] = coverage;
+    }
+}
+
+/// \brief Reference Line, Exact Coverage of Each Pixel
+static void _ref_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    uint8_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        int16_t t = x0;
+        x0 = y0, y0 = t;
+        t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1)
+    {
+        int16_t t = x0;
+        x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+
+    int8_t step = (y0 < y1) ? 1 : -1;
+    for (int16_t x = x0; x <= x1; x++)
+    {
+        double  y    = (x1 == x0) ? y0 : y0 + (double)(y1 - y0) * (x - x0) / (x1 - x0);
+        int16_t base = (int16_t)(step > 0 ? floor(y) : ceil(y));
+        double  frac = fabs(y - base);
+        if (steep)
+        {
+            _ref_pixel(base, x, 1 - frac);
+            _ref_pixel(base + step, x, frac);
+        }
+        else
+        {
+            _ref_pixel(x, base, 1 - frac);
+            _ref_pixel(x, base + step, frac);
+        }
+    }
+}
+
+/// \brief Check a Channel Against the Blends Around a Level
+/// \param value Channel of the pixel
+/// \param fg Channel of the line color
+/// \param bg Channel of the background
+/// \param level Exact level, 0 - LEVELS
+static uint8_t _channel_ok(int16_t value, int16_t fg, int16_t bg, double level)
+{
+    double lo = level - 1 < 0 ? 0 : level - 1;
+    double hi = level + 1 > LEVELS ? LEVELS : level + 1;
+    double a  = bg + (fg - bg) * lo / LEVELS;
+    double b  = bg + (fg - bg) * hi / LEVELS;
+    return value >= fmin(a, b) - 1 && value <= fmax(a, b) + 1;
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < LINES; n++)
+    {
+        int16_t  x0 = check_random(-30, ST7735_WIDTH + 30), y0 = check_random(-30, ST7735_HEIGHT + 30);
+        int16_t  x1 = check_random(-30, ST7735_WIDTH + 30), y1 = check_random(-30, ST7735_HEIGHT + 30);
+        uint16_t color = _colors[check_random(0, 10)];
+        uint16_t bg    = _colors[check_random(0, 10)];
+        if (n % 20 == 0)
+        {
+            y1 = y0;  // Horizontal
+        }
+        else if (n % 20 == 1)
+        {
+            x1 = x0 + (y1 - y0);  // Diagonal
+        }
+
+        for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+        {
+            for (int16_t x = 0; x < ST7735_WIDTH; x++)
+            {
+                _coverage[y][x] = 0;
+            }
+        }
+        _ref_line(x0, y0, x1, y1);
+
+        tft_wait();
+        emu_flush();
+        emu_fill(bg);
+        tft_draw_line_aa(x0, y0, x1, y1, color, bg);
+        tft_wait();
+        emu_flush();
+
+        uint32_t errors = 0;
+        for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+        {
+            for (int16_t x = 0; x < ST7735_WIDTH; x++)
+            {
+                uint16_t p     = emu_pixel(x, y);
+                double   level = _coverage[y][x] * LEVELS;
+                uint8_t  ok    = _channel_ok(p >> 11, color >> 11, bg >> 11, level) &&
+                             _channel_ok((p >> 5) & 0x3F, (color >> 5) & 0x3F, (bg >> 5) & 0x3F, level) &&
+                             _channel_ok(p & 0x1F, color & 0x1F, bg & 0x1F, level);
+                if (!ok && !errors++)
+                {
+                    printf("(%d, %d) - (%d, %d) %04x on %04x: (%d, %d) is %04x, level %.2f\n", x0, y0, x1, y1, color,
+                           bg, x, y, p, level);
+                }
+            }
+        }
+        CHECK(errors == 0);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,88 @@
+/// \brief Test of the Pattern Fill
+///
+/// \details Random tiles of random sizes fill random rectangles, many of
+/// them partly off the screen, so that rows start inside a tile and end with
+/// a partial one. Small tiles go through the DMA buffer, larger ones are sent
+/// from the tile itself. The screen is compared with the tile repeated from
+/// the corner of the rectangle, one pixel at a time, and each visible pixel
+/// must be written once.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#define PATTERNS 1000
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels set by the reference
+
+static uint8_t _tile[200 * 40 * 2];
+
+/// \brief Reference Fill, One Pixel at a Time
+static void _ref_pattern(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t tw, uint16_t th)
+{
+    for (int16_t j = 0; j < h; j++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            if (x + i >= 0 && x + i < ST7735_WIDTH && y + j >= 0 && y + j < ST7735_HEIGHT)
+            {
+                const uint8_t* p   = &_tile[((j % th) * tw + i % tw) << 1];
+                _ref[y + j][x + i] = (p[0] << 8) | p[1];
+                _ref_pixels++;
+            }
+        }
+    }
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < PATTERNS; n++)
+    {
+        uint16_t tw, th;
+        switch (n % 4)
+        {
+            case 0:
+            case 1:
+                // Through the DMA buffer
+                tw = check_random(1, 40);
+                th = check_random(1, ST7735_WIDTH / tw);
+                break;
+            case 2:
+                tw = check_random(5, 100);
+                th = check_random(ST7735_WIDTH / tw + 1, 40);
+                break;
+            default:
+                // Wider than the screen
+                tw = check_random(ST7735_WIDTH, 200);
+                th = check_random(1, 40);
+                break;
+        }
+        int16_t x = check_random(-250, ST7735_WIDTH), y = check_random(-60, ST7735_HEIGHT);
+        int16_t w = check_random(0, 300), h = check_random(0, 100);
+        for (uint16_t i = 0; i < tw * th * 2; i++)
+        {
+            _tile[i] = check_random(0, 255);
+        }
+
+        check_clear(_ref, BLACK);
+        _ref_pixels = 0;
+        _ref_pattern(x, y, w, h, tw, th);
+        tft_fill_pattern(x, y, w, h, _tile, tw, th);
+
+        char what[80];
+        snprintf(what, sizeof(what), "(%d, %d) %dx%d tile %dx%d", x, y, w, h, tw, th);
+        CHECK(check_screen(_ref, what) == 0);
+        CHECK(emu_stats.pixels == _ref_pixels);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
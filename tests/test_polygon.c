@@ -0,0 +1,160 @@
+/// \brief Test of the Polygon Fill
+///
+/// \details Random polygons, non-convex and self-intersecting, are compared
+/// with a point-in-polygon reference for the even-odd and the non-zero
+/// winding rule. A pixel is sampled at (x + 0.5, y): an edge covers the rows
+/// from its top vertex down to, not including, its bottom vertex, and counts
+/// when it crosses the row left of the sample point. The reference is exact
+/// in integers. The fill steps its edges in 16.16 fixed point, which stays
+/// exact to the sample spacing for edges of up to 180 rows, so the polygons
+/// are kept that tall. Each visible pixel must be written once.
+///
+/// Polygons with more than 16 edges crossing a row must not be drawn.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#define POLYGONS 600
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels set by the reference
+
+// Vertices of a star and of an octagon around the center, radius 100
+static const int8_t _star[5][2]    = {{0, -100}, {59, 81}, {-95, -31}, {95, -31}, {-59, 81}};
+static const int8_t _octagon[9][2] = {{0, -100}, {71, -71}, {100, 0},   {71, 71}, {0, 100},
+                                      {-71, 71}, {-100, 0}, {-71, -71}, {0, -100}};
+
+/// \brief Reference Fill, One Pixel at a Time
+static void _ref_polygon(const point_t* points, uint16_t n, uint16_t color, uint8_t non_zero)
+{
+    for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+    {
+        for (int16_t x = 0; x < ST7735_WIDTH; x++)
+        {
+            int16_t        winding = 0;
+            const point_t* p0      = &points[n - 1];
+            for (uint16_t i = 0; i < n; i++)
+            {
+                const point_t* p1  = &points[i];
+                const point_t* top = (p0->y < p1->y) ? p0 : p1;
+                const point_t* bot = (p0->y < p1->y) ? p1 : p0;
+                if (top->y <= y && y < bot->y)
+                {
+                    // Crossing left of x + 0.5: top.x + dx * (y - top.y) / dy < x + 0.5
+                    int32_t dy = bot->y - top->y;
+                    if (2 * ((int32_t)top->x * dy + (int32_t)(bot->x - top->x) * (y - top->y)) < (2 * x + 1) * dy)
+                    {
+                        winding += non_zero ? ((p0 == top) ? 1 : -1) : 1;
+                    }
+                }
+                p0 = p1;
+            }
+            if (non_zero ? winding != 0 : (winding & 1))
+            {
+                _ref[y][x] = color;
+                _ref_pixels++;
+            }
+        }
+    }
+}
+
+static void _fill(const point_t* points, uint16_t n, uint16_t color, uint8_t non_zero)
+{
+    if (non_zero)
+    {
+        tft_fill_polygon_non_zero(points, n, color);
+    }
+    else
+    {
+        tft_fill_polygon(points, n, color);
+    }
+}
+
+/// \brief Compare a Polygon with the Reference
+static void _check(const point_t* points, uint16_t n, uint8_t non_zero, const char* what)
+{
+    check_clear(_ref, BLACK);
+    _ref_pixels = 0;
+    _ref_polygon(points, n, WHITE, non_zero);
+    _fill(points, n, WHITE, non_zero);
+
+    char label[80];
+    snprintf(label, sizeof(label), "%s, %s", what, non_zero ? "non-zero" : "even-odd");
+    CHECK(check_screen(_ref, label) == 0);
+    CHECK(emu_stats.pixels == _ref_pixels);
+}
+
+/// \brief Zigzag with One Edge per Vertex Crossing the Middle Row
+static void _zigzag(point_t* points, uint16_t n)
+{
+    for (uint16_t i = 0; i < n; i++)
+    {
+        points[i].x = 5 + i * 8;
+        points[i].y = (i & 1) ? 70 : 10;
+    }
+}
+
+static int _test(void)
+{
+    point_t points[40];
+
+    tft_init();
+
+    for (uint16_t p = 0; p < POLYGONS; p++)
+    {
+        uint16_t n = check_random(3, 12);
+        for (uint16_t i = 0; i < n; i++)
+        {
+            points[i].x = check_random(-40, ST7735_WIDTH + 40);
+            points[i].y = check_random(-50, 130);
+        }
+        _check(points, n, p & 1, "random");
+    }
+
+    // A star and a convex polygon of many vertices, anywhere on the screen
+    for (uint16_t p = 0; p < 40; p++)
+    {
+        int16_t x = check_random(0, ST7735_WIDTH), y = check_random(0, ST7735_HEIGHT);
+        int16_t r = check_random(10, 80);
+
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            points[i].x = x + _star[i][0] * r / 100;
+            points[i].y = y + _star[i][1] * r / 100;
+        }
+        _check(points, 5, p & 1, "star");
+
+        for (uint8_t i = 0; i < 40; i++)
+        {
+            // 5 vertices on each side of the octagon
+            int16_t s = i / 5, t = i % 5;
+            points[i].x = x + (_octagon[s][0] * (5 - t) + _octagon[s + 1][0] * t) * r / 500;
+            points[i].y = y + (_octagon[s][1] * (5 - t) + _octagon[s + 1][1] * t) * r / 500;
+        }
+        _check(points, 40, p & 1, "40 vertices");
+    }
+
+    // 16 edges cross the middle rows: drawn
+    _zigzag(points, 16);
+    _check(points, 16, 0, "16 edges on a row");
+    _check(points, 16, 1, "16 edges on a row");
+
+    // 18 edges: nothing is drawn
+    _zigzag(points, 18);
+    for (uint8_t non_zero = 0; non_zero < 2; non_zero++)
+    {
+        check_clear(_ref, BLACK);
+        _fill(points, 18, WHITE, non_zero);
+        CHECK(check_screen(_ref, "18 edges on a row") == 0);
+        CHECK(emu_stats.bytes == 0);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,290 @@
+/// \brief Test of the Text Box
+///
+/// \details Random texts of words, runs of spaces and '\n' are printed in
+/// random boxes, in the built-in font at 1x and 2x and in the proportional
+/// font of test_font.bdf, with every alignment. A greedy wrap on the host
+/// breaks each line after its last word that fits: the spaces after that
+/// word are not part of the line and the spaces before the next line are
+/// skipped, but spaces after '\n' or at the start of the text are kept. A
+/// first word wider than the box is cut to the characters that fit, at
+/// least one. The reference prints each line with tft_print() where the
+/// wrap and the alignment put it, over the box filled with the background.
+/// With a background, every pixel of the box must be written exactly once.
+///
+/// tft_text_extent() is checked on its own.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <string.h>
+
+#include "check.h"
+#include "font_test.h"
+
+#define BOXES 1500
+
+static screen_t _ref;
+
+static const char*    _words[] = {"A", "Wo", "jxA", "WWW", "1234", "oooooooooooo", "-7", "x"};
+static const font_t*  _font;  // Font of the reference, 0 - Built-in 5x7 font
+static uint8_t        _size;  // Text size of the reference
+static const uint16_t _colors[] = {WHITE, RED, GREEN, BLUE, YELLOW, CYAN, NAVY, ORANGE};
+
+/// \brief Width of Characters as Printed
+static int16_t _width(const char* str, uint16_t n)
+{
+    int16_t w = 0;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        uint8_t c = str[i];
+        if (!_font)
+        {
+            w += 6 * _size;
+        }
+        else if (c >= _font->first && c <= _font->last)
+        {
+            w += _font->glyphs[c - _font->first].advance * _size;
+        }
+    }
+    return (n && !_font) ? w - _size : w;  // No gap after the last 5x7 character
+}
+
+/// \brief Greedy Wrap of One Line
+/// \param str Text, moved to the start of the following line.
+/// \param w Width of the box
+/// \param lw Width of the line
+/// \return Number of characters of the line
+static uint16_t _ref_wrap(const char** str, int16_t w, int16_t* lw)
+{
+    const char* p    = *str;
+    int16_t     best = -1;  // Longest line ending after a word
+    uint16_t    end  = 0;   // First '\n' or '\0'
+    for (;; end++)
+    {
+        char c = p[end];
+        if ((c == ' ' || c == '\n' || c == '\0') && (end == 0 || p[end - 1] != ' '))
+        {
+            if (_width(p, end) > w)
+            {
+                break;
+            }
+            best = end;
+        }
+        if (c == '\n' || c == '\0')
+        {
+            break;
+        }
+    }
+    while (p[end] != '\n' && p[end] != '\0')
+    {
+        end++;
+    }
+
+    uint16_t fit = 0;  // Characters fitting in the box
+    while (fit < end && _width(p, fit + 1) <= w)
+    {
+        fit++;
+    }
+
+    if (best <= 0 && fit < end)
+    {
+        // The first word is cut
+        uint16_t len = fit ? fit : 1;
+        *lw          = _width(p, len);
+        *str         = p + len;
+        return len;
+    }
+
+    uint16_t len = best > 0 ? best : 0;
+    *lw          = _width(p, len);
+    p += len;
+    while (*p == ' ')
+    {
+        p++;
+    }
+    if (*p == '\n')
+    {
+        p++;
+    }
+    *str = p;
+    return len;
+}
+
+/// \brief Reference Text Box
+/// \return Pixels the box must write: the box and any character wider than
+/// it, only the text when transparent.
+static uint32_t _ref_box(int16_t x, int16_t y, int16_t w, int16_t h, const char* str, uint8_t align,
+                         uint8_t transparent)
+{
+    int16_t glyph_h = (_font ? _font->height : 7) * _size;
+    int16_t line_h  = glyph_h + (_font ? 0 : _size);
+    int16_t text_h  = 0, lw;
+
+    for (const char* s = str; *s && text_h + glyph_h <= h;)
+    {
+        _ref_wrap(&s, w, &lw);
+        text_h += line_h;
+    }
+    if (text_h)
+    {
+        text_h -= line_h - glyph_h;
+    }
+    int16_t ty = y + ((align & TEXT_ALIGN_MIDDLE) ? (h - text_h) >> 1 : (align & TEXT_ALIGN_BOTTOM) ? h - text_h : 0);
+
+    if (!transparent)
+    {
+        tft_fill_rect(x, y, w, h, BLACK);
+    }
+    tft_wait();
+    emu_flush();
+    emu_reset_stats();
+
+    uint32_t overflow = 0;  // Pixels of characters past the box
+    for (int16_t end = ty + text_h; ty < end; ty += line_h)
+    {
+        const char* line = str;
+        uint16_t    len  = _ref_wrap(&str, w, &lw);
+        int16_t     room = lw < w ? w - lw : 0;  // A character wider than the box starts at its left
+        int16_t     lx   = x + ((align & TEXT_ALIGN_CENTER) ? room >> 1 : (align & TEXT_ALIGN_RIGHT) ? room : 0);
+
+        char text[64];
+        memcpy(text, line, len);
+        text[len] = '\0';
+        tft_set_cursor(lx, ty);
+        tft_print(text);
+
+        // Visible part right of the box
+        int16_t x0 = x + w < 0 ? 0 : x + w, x1 = lx + lw > ST7735_WIDTH ? ST7735_WIDTH : lx + lw;
+        int16_t y0 = ty < 0 ? 0 : ty, y1 = ty + glyph_h > ST7735_HEIGHT ? ST7735_HEIGHT : ty + glyph_h;
+        if (!transparent && x1 > x0 && y1 > y0)
+        {
+            overflow += (uint32_t)(x1 - x0) * (y1 - y0);
+        }
+    }
+    tft_wait();
+    emu_flush();
+    check_save(_ref);
+    if (transparent)
+    {
+        return emu_stats.pixels;
+    }
+
+    int16_t x0 = x < 0 ? 0 : x, x1 = x + w > ST7735_WIDTH ? ST7735_WIDTH : x + w;
+    int16_t y0 = y < 0 ? 0 : y, y1 = y + h > ST7735_HEIGHT ? ST7735_HEIGHT : y + h;
+    return ((x1 > x0 && y1 > y0) ? (uint32_t)(x1 - x0) * (y1 - y0) : 0) + overflow;
+}
+
+/// \brief Compare a Text Box with the Reference
+static void _check(int16_t x, int16_t y, int16_t w, int16_t h, const char* str, uint8_t align, uint8_t transparent)
+{
+    tft_set_font(_font);
+    tft_set_text_size(_size);
+    tft_set_transparent(transparent);
+
+    check_clear(_ref, MAGENTA);
+    uint32_t pixels = _ref_box(x, y, w, h, str, align, transparent);
+
+    emu_fill(MAGENTA);
+    emu_reset_stats();
+    tft_print_box(x, y, w, h, str, align);
+
+    char    text[64], what[160];
+    uint8_t i = 0;
+    for (; str[i]; i++)
+    {
+        text[i] = (str[i] == '\n') ? '/' : str[i];  // One line of output
+    }
+    text[i] = '\0';
+    snprintf(what, sizeof(what), "\"%s\" in (%d, %d) %dx%d align %d, %s %dx%s", text, x, y, w, h, align,
+             _font ? "font" : "5x7", _size, transparent ? " transparent" : "");
+    CHECK(check_screen(_ref, what) == 0);
+    CHECK(emu_stats.pixels == pixels);
+}
+
+/// \brief Check the Size of a String
+static void _check_extent(const char* str, uint16_t width, uint16_t height)
+{
+    uint16_t w, h;
+    tft_text_extent(str, &w, &h);
+    if (w != width || h != height)
+    {
+        printf("\"%s\" %s %dx: %dx%d, expected %dx%d\n", str, _font ? "font" : "5x7", _size, w, h, width, height);
+    }
+    CHECK(w == width && h == height);
+}
+
+static int _test(void)
+{
+    tft_init();
+    tft_set_color(WHITE);
+    tft_set_background_color(BLACK);
+
+    for (uint8_t f = 0; f < 2; f++)
+    {
+        _font = f ? &font_test : 0;
+        for (_size = 1; _size <= 2; _size++)
+        {
+            tft_set_font(_font);
+            tft_set_text_size(_size);
+            _check_extent("", 0, (f ? 16 : 7) * _size);
+            _check_extent("A", (f ? 12 : 5) * _size, (f ? 16 : 7) * _size);
+            _check_extent("A W", (f ? 34 : 17) * _size, (f ? 16 : 7) * _size);
+            _check_extent("-17", (f ? 21 : 17) * _size, (f ? 16 : 7) * _size);
+            _check_extent("QQ", f ? 0 : 11 * _size, (f ? 16 : 7) * _size);  // No glyph in the font
+
+            // Leading, consecutive and trailing spaces, '\n'
+            _check(10, 5, 80, 60, "  A Wo  jxA   WWW  ", TEXT_ALIGN_RIGHT, 0);
+            _check(10, 5, 80, 60, "A  \n  Wo\n\nx  \n", TEXT_ALIGN_CENTER | TEXT_ALIGN_MIDDLE, 0);
+            _check(0, 0, 40, 70, "oooooooooooo WWW", TEXT_ALIGN_LEFT | TEXT_ALIGN_BOTTOM, 0);
+
+            // Narrower than one character
+            _check(20, 10, 3, 40, "AW x", TEXT_ALIGN_CENTER, 0);
+            _check(150, 10, 2, 40, "W", TEXT_ALIGN_RIGHT, 1);
+        }
+    }
+
+    for (uint16_t n = 0; n < BOXES; n++)
+    {
+        _font = (n & 2) ? &font_test : 0;
+        _size = check_random(1, 2);
+
+        char    str[64];
+        uint8_t len = 0;
+        while (len < 40)
+        {
+            int16_t r = check_random(0, 9);
+            if (r < 6)
+            {
+                const char* word = _words[check_random(0, 7)];
+                strcpy(&str[len], word);
+                len += strlen(word);
+            }
+            else if (r < 9)
+            {
+                for (int16_t i = check_random(1, 3); i; i--)
+                {
+                    str[len++] = ' ';
+                }
+            }
+            else
+            {
+                str[len++] = '\n';
+            }
+        }
+        str[len = check_random(0, len)] = '\0';
+
+        int16_t x = check_random(-20, ST7735_WIDTH - 10), y = check_random(-10, ST7735_HEIGHT - 10);
+        int16_t w = check_random(0, 9) ? check_random(10, 150) : check_random(0, 10);
+        int16_t h = check_random(0, 90);
+        uint8_t align = check_random(0, 2) | (check_random(0, 2) << 2);
+        tft_set_color(_colors[check_random(0, 7)]);
+        _check(x, y, w, h, str, align, n & 1);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
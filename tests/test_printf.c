@@ -0,0 +1,312 @@
+/// \brief Test of tft_printf() Against tft_print()
+///
+/// \details tft_printf() draws its text in chunks as it is formatted. Over a
+/// screen filled with another color, every string must come out exactly like
+/// tft_print() of the same text, including the background gap between the
+/// characters at a chunk boundary. The conversions are checked against the
+/// text of snprintf() printed with tft_print().
+///
+/// tft_print_fixed(), tft_print_number_padded() and tft_print_hex() are
+/// checked against their expected text, tft_print_number() against the
+/// text moved right by the test, with the built-in font at 1x and 2x and
+/// with the proportional font of test_font.bdf.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "check.h"
+#include "font_test.h"
+
+static screen_t _expected;
+
+// Longer than a byte can count
+static char _long[301];
+
+// A conversion, compared with snprintf() unless the text is given.
+static const struct
+{
+    const char* format;
+    int32_t     num;
+    const char* str;       // Argument instead of the number if not NULL
+    const char* expected;  // NULL - Text of snprintf()
+} _conversions[] = {
+    {"%d", 0},
+    {"%d", 7},
+    {"%d", -7},
+    {"%d", INT32_MAX},
+    {"%d", INT32_MIN},
+    {"%u", 0},
+    {"%u", 4000000000u},
+    {"%x", 0},
+    {"%x", 0xBEEF},
+    {"%X", 0xBEEF},
+    {"%x", -1},
+    {"%X", 0xDEADBEEF},
+    {"%5d", 42},
+    {"%5d", -42},
+    {"%2d", 12345},
+    {"%-5d|", 42},
+    {"%-5d|", -42},
+    {"%05d", 42},
+    {"%05d", -42},
+    {"%012d", 7},
+    {"%012d", INT32_MIN},
+    {"%010x", 0xBEEF},
+    {"%010X", 0xBEEF},
+    {"%-08d|", 7},
+    {"%8u", 4000000000u},
+    {"%300d", 7},
+    {"%0300d", -7},
+    {"%-300d|", 7},
+    {"%s", 0, _long},
+    {"%310s", 0, _long},
+    {"%-310s|", 0, _long},
+    {"%05s", 0, "ab"},
+    {"100%%", 0},
+    {"%y%d", 3, NULL, "%y3"},
+    {"%-5y", 0, NULL, "%-5y"},
+    {"100%", 0, NULL, "100%"},
+};
+
+// A formatter and the text it must print
+enum
+{
+    FIXED,
+    PADDED,
+    HEX,
+};
+static const struct
+{
+    uint8_t     formatter;
+    int32_t     num;
+    uint8_t     digits;  // Fraction or minimum digits
+    const char* expected;
+} _formatters[] = {
+    {FIXED, 5, 2, "0.05"},
+    {FIXED, -5, 2, "-0.05"},
+    {FIXED, 2345, 2, "23.45"},
+    {FIXED, -2345, 1, "-234.5"},
+    {FIXED, 0, 3, "0.000"},
+    {FIXED, 7, 0, "7"},
+    {FIXED, 1, 9, "0.000000001"},
+    {FIXED, -1, 9, "-0.000000001"},
+    {FIXED, 1, 12, "0.000000001"},  // At most 9 fraction digits
+    {FIXED, INT32_MAX, 10, "2.147483647"},
+    {FIXED, INT32_MIN, 9, "-2.147483648"},
+    {FIXED, INT32_MIN, 0, "-2147483648"},
+    {PADDED, 0, 0, "0"},
+    {PADDED, 42, 1, "42"},
+    {PADDED, 42, 5, "00042"},
+    {PADDED, -42, 5, "-00042"},
+    {PADDED, INT32_MIN, 10, "-2147483648"},
+    {PADDED, INT32_MAX, 3, "2147483647"},
+    {HEX, 0, 0, "0"},
+    {HEX, 0xBEEF, 0, "BEEF"},
+    {HEX, 0xBEEF, 8, "0000BEEF"},
+    {HEX, 0xDEADBEEF, 2, "DEADBEEF"},
+};
+
+/// \brief Clear the Screen
+/// \param size Text size, at 2x the text starts off the screen so the first
+/// chunk boundary is visible.
+static void _clear(uint8_t size)
+{
+    tft_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, GREEN);
+    tft_set_cursor(size > 1 ? -100 : 2, 3);
+}
+
+static void _save(void)
+{
+    tft_wait();
+    emu_flush();
+    check_save(_expected);
+}
+
+/// \brief Clear the Screen for a Text
+/// \param text Expected text, the end of it is visible.
+static void _clear_for(const char* text)
+{
+    tft_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, GREEN);
+    tft_set_cursor(ST7735_WIDTH - 2 - 6 * (int16_t)strlen(text), 3);
+}
+
+static uint32_t _mismatches(const char* str, uint8_t size)
+{
+    tft_wait();
+    emu_flush();
+
+    char what[80];
+    snprintf(what, sizeof(what), "\"%s\" at %dx", str, size);
+    return check_mismatches(_expected, what);
+}
+
+/// \brief Check the Right Alignment of tft_print_number()
+/// \param num Number to print
+/// \param width Width to align in
+/// \param size Text size
+/// \param font Proportional font, 0 - Built-in 5x7 font
+/// \details A '|' printed after the number shows where the cursor ends.
+static void _check_number(int32_t num, uint16_t width, uint8_t size, const font_t* font)
+{
+    char str[13];
+    snprintf(str, sizeof(str), "%d", num);
+
+    // Width of the number, the built-in font has no gap after the last character
+    int16_t w = font ? 0 : -size;
+    for (const char* c = str; *c; c++)
+    {
+        w += (font ? font->glyphs[*c - font->first].advance : 6) * size;
+    }
+
+    tft_set_font(font);
+    tft_set_text_size(size);
+    tft_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, GREEN);
+    tft_set_cursor(4 + (width > w ? width - w : 0), 3);
+    tft_print(str);
+    tft_print("|");
+    _save();
+
+    tft_fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, GREEN);
+    tft_set_cursor(4, 3);
+    tft_print_number(num, width);
+    tft_print("|");
+
+    char what[40];
+    snprintf(what, sizeof(what), "%s in %d, %s", str, width, font ? "font" : "5x7");
+    CHECK(_mismatches(what, size) == 0);
+}
+
+static int _test(void)
+{
+    static const char* strings[] = {
+        "0123456789abcde",                   // One short of a chunk
+        "0123456789abcdef",                  // Exactly one chunk
+        "0123456789abcdefg",                 // One past
+        "0123456789abcdef0123456789abcdef",  // Two chunks
+    };
+
+    tft_init();
+    tft_set_color(WHITE);
+    tft_set_background_color(BLUE);
+
+    for (uint8_t size = 1; size <= 2; size++)
+    {
+        tft_set_text_size(size);
+        for (uint8_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+        {
+            _clear(size);
+            tft_print(strings[i]);
+            _save();
+
+            _clear(size);
+            tft_printf("%s", strings[i]);
+            CHECK(_mismatches(strings[i], size) == 0);
+
+            // Formatted in pieces
+            char head[8];
+            strncpy(head, strings[i], 7);
+            head[7] = '\0';
+            _clear(size);
+            tft_printf("%s%c%s", head, strings[i][7], strings[i] + 8);
+            CHECK(_mismatches(strings[i], size) == 0);
+        }
+    }
+
+    tft_set_text_size(1);
+    memset(_long, 'L', sizeof(_long) - 1);
+    for (uint8_t i = 0; i < sizeof(_conversions) / sizeof(_conversions[0]); i++)
+    {
+        char text[400];
+        if (_conversions[i].expected)
+        {
+            strcpy(text, _conversions[i].expected);
+        }
+        else if (_conversions[i].str)
+        {
+            snprintf(text, sizeof(text), _conversions[i].format, _conversions[i].str);
+        }
+        else
+        {
+            snprintf(text, sizeof(text), _conversions[i].format, _conversions[i].num);
+        }
+
+        _clear_for(text);
+        tft_print(text);
+        _save();
+
+        _clear_for(text);
+        if (_conversions[i].str)
+        {
+            tft_printf(_conversions[i].format, _conversions[i].str);
+        }
+        else
+        {
+            tft_printf(_conversions[i].format, _conversions[i].num);
+        }
+        CHECK(_mismatches(_conversions[i].format, 1) == 0);
+    }
+
+    for (uint8_t i = 0; i < sizeof(_formatters) / sizeof(_formatters[0]); i++)
+    {
+        const char* text = _formatters[i].expected;
+        _clear_for(text);
+        tft_print(text);
+        _save();
+
+        _clear_for(text);
+        switch (_formatters[i].formatter)
+        {
+            case FIXED:
+                tft_print_fixed(_formatters[i].num, _formatters[i].digits);
+                break;
+            case PADDED:
+                tft_print_number_padded(_formatters[i].num, _formatters[i].digits);
+                break;
+            default:
+                tft_print_hex(_formatters[i].num, _formatters[i].digits);
+                break;
+        }
+        CHECK(_mismatches(text, 1) == 0);
+    }
+
+    // Every padded width
+    for (uint8_t digits = 1; digits <= 10; digits++)
+    {
+        static const int32_t nums[] = {0, 7, -7, 123456, INT32_MIN};
+        for (uint8_t i = 0; i < sizeof(nums) / sizeof(nums[0]); i++)
+        {
+            char text[16];
+            snprintf(text, sizeof(text), "%.*d", digits, nums[i]);
+            _clear_for(text);
+            tft_print(text);
+            _save();
+
+            _clear_for(text);
+            tft_print_number_padded(nums[i], digits);
+            CHECK(_mismatches(text, 1) == 0);
+        }
+    }
+
+    // Right alignment, wider and narrower than the number
+    for (uint8_t size = 1; size <= 2; size++)
+    {
+        for (uint8_t f = 0; f < 2; f++)
+        {
+            const font_t* font = f ? &font_test : 0;
+            _check_number(42, 60, size, font);
+            _check_number(-1234, 100, size, font);
+            _check_number(INT32_MIN, 20, size, font);
+            _check_number(7, 0, size, font);
+        }
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,147 @@
+/// \brief Test of the Ring Gauges and Sectors
+///
+/// \details Random ring gauges, many of them partly off the screen, are drawn
+/// at one value and updated to another. The screen must match the gauge drawn
+/// at the new value from scratch, and the update must write exactly the
+/// pixels that differ between the two values. Up to a full scale of 2896,
+/// the value angles must be exact.
+///
+/// Rings, pies and arcs are also cut into sectors at random angles, the last
+/// ending where the first starts. The sectors must cover the pixels of the
+/// whole ring, each one exactly once.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#define RINGS  600
+#define SPLITS 400
+
+static screen_t _ref, _old;
+
+static const uint16_t _colors[] = {WHITE, RED, GREEN, BLUE, YELLOW, CYAN, ORANGE, PINK};
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < RINGS; n++)
+    {
+        ring_t ring;
+        ring.x         = check_random(-20, ST7735_WIDTH + 20);
+        ring.y         = check_random(-20, ST7735_HEIGHT + 20);
+        ring.r         = check_random(0, 60);
+        ring.ir        = check_random(0, ring.r);
+        ring.start     = check_random(-400, 400);
+        ring.sweep     = check_random(1, 360);
+        ring.max_value = check_random(1, n & 1 ? 100 : 5000);
+        ring.color     = GREEN;
+        ring.bg_color  = DARKGREY;
+        uint16_t v0 = check_random(0, ring.max_value + 10), v1 = check_random(0, ring.max_value + 10);
+
+        // Both values from scratch
+        check_clear(_old, BLACK);
+        tft_draw_ring(&ring, v0);
+        tft_wait();
+        emu_flush();
+        check_save(_old);
+        check_clear(_ref, BLACK);
+        tft_draw_ring(&ring, v1);
+        tft_wait();
+        emu_flush();
+        check_save(_ref);
+
+        // Exact angles up to a full scale of 2896
+        char what[100];
+        snprintf(what, sizeof(what), "(%d, %d) r %d ir %d start %d sweep %d max %d: %d to %d", ring.x, ring.y, ring.r,
+                 ring.ir, ring.start, ring.sweep, ring.max_value, v0, v1);
+        if (ring.max_value <= 2896)
+        {
+            int16_t angle = ring.start + ((v1 < ring.max_value) ? ring.sweep * v1 / ring.max_value : ring.sweep);
+            emu_fill(BLACK);
+            tft_fill_arc(ring.x, ring.y, ring.r, ring.ir, ring.start, angle, ring.color);
+            tft_fill_arc(ring.x, ring.y, ring.r, ring.ir, angle, ring.start + ring.sweep, ring.bg_color);
+            CHECK(check_screen(_ref, what) == 0);
+        }
+
+        uint32_t changed = 0;
+        for (int16_t y = 0; y < ST7735_HEIGHT; y++)
+        {
+            for (int16_t x = 0; x < ST7735_WIDTH; x++)
+            {
+                changed += _old[y][x] != _ref[y][x];
+            }
+        }
+
+        // Update from the old value
+        emu_fill(BLACK);
+        tft_draw_ring(&ring, v0);
+        tft_wait();
+        emu_flush();
+        emu_reset_stats();
+        tft_update_ring(&ring, v0, v1);
+        CHECK(check_screen(_ref, what) == 0);
+        CHECK(emu_stats.pixels == changed);
+    }
+
+    for (uint16_t n = 0; n < SPLITS; n++)
+    {
+        int16_t  x = check_random(-20, ST7735_WIDTH + 20), y = check_random(-20, ST7735_HEIGHT + 20);
+        uint16_t r  = check_random(0, 60);
+        uint16_t ir = (n % 3 == 0) ? 0 : (n % 3 == 1) ? r : check_random(0, r);
+        int16_t  start = check_random(-400, 400);
+
+        // The whole ring
+        check_clear(_ref, BLACK);
+        tft_fill_arc(x, y, r, ir, start, start + 360, WHITE);
+        tft_wait();
+        emu_flush();
+        check_save(_ref);
+        uint32_t pixels = emu_stats.pixels;
+
+        // Sectors between increasing angles
+        emu_fill(BLACK);
+        emu_reset_stats();
+        int16_t a = start;
+        for (uint8_t i = 0; a < start + 360; i++)
+        {
+            int16_t  b     = (i == 7) ? start + 360 : a + check_random(1, 120);
+            uint16_t color = _colors[i & 7];
+            b              = (b > start + 360) ? start + 360 : b;
+            if (ir == 0 && (i & 1))
+            {
+                tft_fill_pie(x, y, r, a, b, color);
+            }
+            else
+            {
+                tft_fill_arc(x, y, r, ir, a, b, color);
+            }
+            a = b;
+        }
+        tft_wait();
+        emu_flush();
+
+        uint32_t errors = 0;
+        for (int16_t py = 0; py < ST7735_HEIGHT; py++)
+        {
+            for (int16_t px = 0; px < ST7735_WIDTH; px++)
+            {
+                if ((emu_pixel(px, py) != BLACK) != (_ref[py][px] == WHITE) && !errors++)
+                {
+                    printf("(%d, %d) r %d ir %d from %d: (%d, %d) %s\n", x, y, r, ir, start, px, py,
+                           _ref[py][px] == WHITE ? "not covered" : "outside the ring");
+                }
+            }
+        }
+        CHECK(errors == 0);
+        CHECK(emu_stats.pixels == pixels);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
@@ -0,0 +1,109 @@
+/// \brief Test of the Rounded Rectangles
+///
+/// \details Random rounded rectangles, outlines of any thickness and fills,
+/// many of them partly off the screen, are compared with a geometric
+/// reference tested one pixel at a time. A corner pixel is inside when
+/// dx^2 + dy^2 <= r^2 + r from the corner center. The hole is the rectangle
+/// inset by the thickness, with corners of radius r - t around the same
+/// centers. Every visible pixel must be written exactly once.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include "check.h"
+
+#define SHAPES 1500
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels set by the reference
+
+/// \brief Check a Pixel Against a Rounded Rectangle
+/// \param i Column from the left of the rectangle
+/// \param j Row from the top of the rectangle
+/// \return 1 if the pixel is inside.
+static uint8_t _inside(int16_t i, int16_t j, int16_t w, int16_t h, int16_t r)
+{
+    if (i < 0 || i >= w || j < 0 || j >= h)
+    {
+        return 0;
+    }
+    int16_t dx = (i < r) ? r - i : (i > w - 1 - r) ? i - (w - 1 - r) : 0;
+    int16_t dy = (j < r) ? r - j : (j > h - 1 - r) ? j - (h - 1 - r) : 0;
+    if (!dy)
+    {
+        return 1;  // Straight part
+    }
+    return (int32_t)dx * dx + (int32_t)dy * dy <= (int32_t)r * r + r;
+}
+
+/// \brief Reference Rounded Rectangle, One Pixel at a Time
+static void _ref_round_rect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, int16_t t, uint16_t color)
+{
+    int16_t half = ((w < h) ? w : h) >> 1;
+    r            = r > half ? half : r;
+
+    for (int16_t j = 0; j < h; j++)
+    {
+        for (int16_t i = 0; i < w; i++)
+        {
+            uint8_t hole = 0;
+            if (t <= half && i >= t && i < w - t && j >= t && j < h - t)
+            {
+                // Inner corners share the outer centers, inset by t
+                int16_t ri = r - t;
+                hole       = ri > 0 ? _inside(i - t, j - t, w - (t << 1), h - (t << 1), ri) : 1;
+            }
+            if (_inside(i, j, w, h, r) && !hole && x + i >= 0 && x + i < ST7735_WIDTH && y + j >= 0 &&
+                y + j < ST7735_HEIGHT)
+            {
+                _ref[y + j][x + i] = color;
+                _ref_pixels++;
+            }
+        }
+    }
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < SHAPES; n++)
+    {
+        int16_t x = check_random(-40, ST7735_WIDTH);
+        int16_t y = check_random(-40, ST7735_HEIGHT);
+        int16_t w = check_random(0, 100);
+        int16_t h = check_random(0, 70);
+        int16_t r = check_random(0, 40);
+        int16_t t = check_random(1, n & 1 ? 4 : 30);
+
+        check_clear(_ref, BLACK);
+        _ref_pixels = 0;
+        switch (n % 4)
+        {
+            case 0:
+                _ref_round_rect(x, y, w, h, r, h, GREEN);
+                tft_fill_round_rect(x, y, w, h, r, GREEN);
+                break;
+            case 1:
+                _ref_round_rect(x, y, w, h, 0, 1, GREEN);
+                tft_draw_rect(x, y, w, h, GREEN);
+                break;
+            default:
+                _ref_round_rect(x, y, w, h, r, t, GREEN);
+                tft_draw_round_rect(x, y, w, h, r, t, GREEN);
+                break;
+        }
+
+        char what[80];
+        snprintf(what, sizeof(what), "(%d, %d) %dx%d r %d t %d, case %d", x, y, w, h, r, t, n % 4);
+        CHECK(check_screen(_ref, what) == 0);
+        CHECK(emu_stats.pixels == _ref_pixels);
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
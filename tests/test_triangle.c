@@ -0,0 +1,211 @@
+/// \brief Test of the Triangle Primitives
+///
+/// \details Random triangles, many of them partly off the screen or flat,
+/// are compared with the fillTriangle() and drawLine() of Adafruit GFX
+/// drawn one pixel at a time. Filled rows must be written exactly once.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <stdlib.h>
+
+#include "check.h"
+
+#define TRIANGLES 3000
+
+static screen_t _ref;
+static uint32_t _ref_pixels;  // Pixels set by the reference
+
+static void _ref_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT && _ref[y][x] != color)
+    {
+        _ref[y][x] = color;
+        _ref_pixels++;
+    }
+}
+
+static void _ref_h_line(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    for (int16_t i = 0; i < w; i++)
+    {
+        _ref_pixel(x + i, y, color);
+    }
+}
+
+static void _swap(int16_t* a, int16_t* b)
+{
+    int16_t t = *a;
+    *a        = *b;
+    *b        = t;
+}
+
+/// \brief fillTriangle() of Adafruit GFX
+static void _ref_fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    int16_t a, b, y, last;
+
+    if (y0 > y1)
+    {
+        _swap(&y0, &y1);
+        _swap(&x0, &x1);
+    }
+    if (y1 > y2)
+    {
+        _swap(&y2, &y1);
+        _swap(&x2, &x1);
+    }
+    if (y0 > y1)
+    {
+        _swap(&y0, &y1);
+        _swap(&x0, &x1);
+    }
+
+    if (y0 == y2)
+    {
+        a = b = x0;
+        if (x1 < a)
+        {
+            a = x1;
+        }
+        else if (x1 > b)
+        {
+            b = x1;
+        }
+        if (x2 < a)
+        {
+            a = x2;
+        }
+        else if (x2 > b)
+        {
+            b = x2;
+        }
+        _ref_h_line(a, y0, b - a + 1, color);
+        return;
+    }
+
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++)
+    {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b)
+        {
+            _swap(&a, &b);
+        }
+        _ref_h_line(a, y, b - a + 1, color);
+    }
+
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++)
+    {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b)
+        {
+            _swap(&a, &b);
+        }
+        _ref_h_line(a, y, b - a + 1, color);
+    }
+}
+
+/// \brief drawLine() of Adafruit GFX
+static void _ref_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    uint8_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        _swap(&x0, &y0);
+        _swap(&x1, &y1);
+    }
+    if (x0 > x1)
+    {
+        _swap(&x0, &x1);
+        _swap(&y0, &y1);
+    }
+
+    int16_t dx    = x1 - x0;
+    int16_t dy    = abs(y1 - y0);
+    int16_t err   = dx >> 1;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+        {
+            _ref_pixel(y0, x0, color);
+        }
+        else
+        {
+            _ref_pixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+static int _test(void)
+{
+    tft_init();
+
+    for (uint16_t n = 0; n < TRIANGLES; n++)
+    {
+        int16_t x[3], y[3];
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            x[i] = check_random(-60, ST7735_WIDTH + 60);
+            y[i] = check_random(-60, ST7735_HEIGHT + 60);
+        }
+        if (n % 10 == 0)
+        {
+            y[n % 3] = y[(n + 1) % 3];  // Flat top or bottom
+        }
+        if (n % 50 == 0)
+        {
+            y[0] = y[1] = y[2];  // One row
+        }
+        uint8_t fill = n & 1;
+
+        check_clear(_ref, BLACK);
+        _ref_pixels = 0;
+        if (fill)
+        {
+            _ref_fill_triangle(x[0], y[0], x[1], y[1], x[2], y[2], YELLOW);
+            tft_fill_triangle(x[0], y[0], x[1], y[1], x[2], y[2], YELLOW);
+        }
+        else
+        {
+            _ref_line(x[0], y[0], x[1], y[1], CYAN);
+            _ref_line(x[1], y[1], x[2], y[2], CYAN);
+            _ref_line(x[2], y[2], x[0], y[0], CYAN);
+            tft_draw_triangle(x[0], y[0], x[1], y[1], x[2], y[2], CYAN);
+        }
+
+        char what[80];
+        snprintf(what, sizeof(what), "%s (%d, %d) (%d, %d) (%d, %d)", fill ? "fill" : "draw", x[0], y[0], x[1], y[1],
+                 x[2], y[2]);
+        CHECK(check_screen(_ref, what) == 0);
+        if (fill)
+        {
+            CHECK(emu_stats.pixels == _ref_pixels);
+        }
+    }
+
+    CHECK(emu_stats.violations == 0);
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
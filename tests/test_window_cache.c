@@ -0,0 +1,364 @@
+/// \brief Test of the Address Window Cache
+///
+/// \details Runs the DrawTest and Mario workloads on the emulator and prints
+/// the bytes sent per phase, next to the bytes of the same command stream
+/// without the cache, where every RAMWR is preceded by CASET and RASET of 5
+/// bytes each. Each phase starts from a cleared screen with the random
+/// sequence of the demo, and its screen must match a reference drawn on the
+/// host, so a skipped CASET or RASET that was needed shows up as misplaced
+/// pixels.
+///
+/// The workloads are the demos as of the window cache change: the moving text
+/// is a filled box with the text printed 5 pixels inside, the Mario frame
+/// is its text only. Only functions of that version of the driver are used,
+/// so the test also builds against it and against the driver before it, see
+/// the Makefile.
+///
+/// \copyright Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0)
+
+#include <stdlib.h>
+
+#include "check.h"
+#include "font5x7.h"
+
+// Screen as drawn by the reference
+static screen_t _ref;
+static int16_t  _ref_x = 0, _ref_y = 0;  // Text cursor
+static uint16_t _ref_color = 0, _ref_bg_color = 0;
+
+static const uint16_t _colors[] = {
+    BLACK, NAVY, DARKGREEN, DARKCYAN, MAROON, PURPLE, OLIVE,  LIGHTGREY,   DARKGREY, BLUE,
+    GREEN, CYAN, RED,       MAGENTA,  YELLOW, WHITE,  ORANGE, GREENYELLOW, PINK,
+};
+
+/// \brief Random Byte Generator of the Demos
+static uint8_t _rand8(void)
+{
+    static uint32_t lfsr = 1;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        uint32_t new_data = (lfsr >> 31) ^ (lfsr >> 21) ^ (lfsr >> 1) ^ lfsr;
+        lfsr              = (lfsr << 1) | (new_data & 1);
+    }
+    return lfsr & 0xFF;
+}
+
+static uint16_t _rand_color(void)
+{
+    return _colors[_rand8() % 19];
+}
+
+static void _ref_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x >= 0 && x < ST7735_WIDTH && y >= 0 && y < ST7735_HEIGHT)
+    {
+        _ref[y][x] = color;
+    }
+}
+
+static void _ref_fill_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+{
+    for (int16_t j = 0; j < height; j++)
+    {
+        for (int16_t i = 0; i < width; i++)
+        {
+            _ref_pixel(x + i, y + j, color);
+        }
+    }
+}
+
+static void _ref_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+{
+    _ref_fill_rect(x, y, width, 1, color);
+    _ref_fill_rect(x, y + height - 1, width, 1, color);
+    _ref_fill_rect(x, y, 1, height, color);
+    _ref_fill_rect(x + width - 1, y, 1, height, color);
+}
+
+/// \brief Classic Bresenham Line of Arduino GFX
+static void _ref_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    int16_t t;
+    uint8_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        t = x0, x0 = y0, y0 = t;
+        t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1)
+    {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+
+    int16_t dx    = x1 - x0;
+    int16_t dy    = abs(y1 - y0);
+    int16_t err   = dx >> 1;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+        {
+            _ref_pixel(y0, x0, color);
+        }
+        else
+        {
+            _ref_pixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+/// \brief 5x7 Text with a Background Gap Between Characters
+static void _ref_print(const char* str)
+{
+    for (; *str; str++)
+    {
+        const unsigned char* start = &font[*str * 5];
+        for (int16_t j = 0; j < 5; j++)
+        {
+            for (int16_t i = 0; i < 7; i++)
+            {
+                _ref_pixel(_ref_x + j, _ref_y + i, (start[j] & (1 << i)) ? _ref_color : _ref_bg_color);
+            }
+        }
+        if (str[1])
+        {
+            _ref_fill_rect(_ref_x + 5, _ref_y, 1, 7, _ref_bg_color);
+        }
+        _ref_x += 6;
+    }
+}
+
+static void _draw_pixel(int16_t x, int16_t y, uint16_t color)
+{
+    tft_draw_pixel(x, y, color);
+    _ref_pixel(x, y, color);
+}
+
+static void _draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    tft_draw_line(x0, y0, x1, y1, color);
+    _ref_line(x0, y0, x1, y1, color);
+}
+
+static void _draw_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    tft_draw_rect(x, y, width, height, color);
+    _ref_rect(x, y, width, height, color);
+}
+
+static void _fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+{
+    tft_fill_rect(x, y, width, height, color);
+    _ref_fill_rect(x, y, width, height, color);
+}
+
+static void _set_colors(uint16_t color, uint16_t bg_color)
+{
+    tft_set_color(color);
+    tft_set_background_color(bg_color);
+    _ref_color    = color;
+    _ref_bg_color = bg_color;
+}
+
+static void _print(int16_t x, int16_t y, const char* str)
+{
+    tft_set_cursor(x, y);
+    tft_print(str);
+    _ref_x = x;
+    _ref_y = y;
+    _ref_print(str);
+}
+
+/// \brief Right-Align a Number in a Field, like tft_print_number()
+static void _print_number(int16_t x, int16_t y, int32_t num, uint16_t width)
+{
+    char str[12];
+    snprintf(str, sizeof(str), "%ld", (long)num);
+    uint16_t num_width = 0;
+    for (const char* p = str; *p; p++)
+    {
+        num_width += 6;
+    }
+    num_width--;
+
+    tft_set_cursor(x, y);
+    tft_print_number(num, width);
+    _ref_x = x + (width > num_width ? width - num_width : 0);
+    _ref_y = y;
+    _ref_print(str);
+}
+
+static void _draw_points(void)
+{
+    for (uint16_t n = 0; n < 30000; n++)
+    {
+        uint8_t x = _rand8() % 160, y = _rand8() % 80;
+        _draw_pixel(x, y, _rand_color());
+    }
+}
+
+static void _scan_v_lines(void)
+{
+    for (uint8_t frame = 0; frame < 50; frame++)
+    {
+        for (uint8_t i = 0; i < 160; i++)
+        {
+            _draw_line(i, 0, i, 80, _rand_color());
+        }
+    }
+}
+
+static void _scan_h_lines(void)
+{
+    for (uint8_t frame = 0; frame < 50; frame++)
+    {
+        for (uint8_t i = 0; i < 80; i++)
+        {
+            _draw_line(0, i, 180, i, _rand_color());
+        }
+    }
+}
+
+static void _draw_lines(void)
+{
+    for (uint16_t n = 0; n < 2000; n++)
+    {
+        uint8_t x0 = _rand8() % 160, y0 = _rand8() % 80;
+        uint8_t x1 = _rand8() % 160, y1 = _rand8() % 80;
+        _draw_line(x0, y0, x1, y1, _rand_color());
+    }
+}
+
+static void _scan_rects(void)
+{
+    for (uint8_t frame = 0; frame < 100; frame++)
+    {
+        for (uint8_t i = 0; i < 40; i++)
+        {
+            _draw_rect(i, i, 160 - (i << 1), 80 - (i << 1), _rand_color());
+        }
+    }
+}
+
+static void _draw_rects(void)
+{
+    for (uint16_t n = 0; n < 5000; n++)
+    {
+        uint8_t x = _rand8() % 140, y = _rand8() % 60;
+        _draw_rect(x, y, 20, 20, _rand_color());
+    }
+}
+
+static void _fill_rects(void)
+{
+    for (uint16_t n = 0; n < 5000; n++)
+    {
+        uint8_t x = _rand8() % 140, y = _rand8() % 60;
+        _fill_rect(x, y, 20, 20, _rand_color());
+    }
+}
+
+static void _move_text(void)
+{
+    uint8_t x = 0, y = 0, step_x = 1, step_y = 1;
+    for (uint16_t n = 0; n < 500; n++)
+    {
+        uint16_t bg = _rand_color();
+        _fill_rect(x, y, 88, 17, bg);
+        _set_colors(_rand_color(), bg);
+        _print(x + 5, y + 5, "Hello, World!");
+
+        x += step_x;
+        if (x >= 72)
+        {
+            step_x = -step_x;
+        }
+        y += step_y;
+        if (y >= 63)
+        {
+            step_y = -step_y;
+        }
+    }
+}
+
+static void _mario_text(void)
+{
+    for (uint16_t count = 0; count < 100; count++)
+    {
+        _set_colors(RED, BLACK);
+        _print(94, 2, "Go Mario!!!");
+        _set_colors(BLUE, BLACK);
+        _print(124, 12, "Run!!!");
+        _set_colors(ORANGE, BLACK);
+        _print(82, 22, "Hit Bricks!!!");
+        _set_colors(PURPLE, BLACK);
+        _print(82, 32, "Beat Monsters");
+        _set_colors(PINK, BLACK);
+        _print(70, 42, "Rescue Princess");
+        _set_colors(WHITE, BLACK);
+        _print(124, 70, "Frames");
+        _print_number(52, 70, count, 65);
+    }
+}
+
+/// \brief Workload Phase
+typedef struct
+{
+    const char* name;
+    void (*run)(void);
+} phase_t;
+
+static const phase_t _phases[] = {
+    {"DrawTest draw point 30000", _draw_points},
+    {"DrawTest scan v-line x50", _scan_v_lines},
+    {"DrawTest scan h-line x50", _scan_h_lines},
+    {"DrawTest draw line 2000", _draw_lines},
+    {"DrawTest scan rect x100", _scan_rects},
+    {"DrawTest draw rect 5000", _draw_rects},
+    {"DrawTest fill rect 5000", _fill_rects},
+    {"DrawTest move text 500", _move_text},
+    {"Mario text, 100 frames", _mario_text},
+};
+
+static int _test(void)
+{
+    // SPI at F_HCLK / 2 like on the chip, a byte leaves before the next
+    // register access. Drivers before the pipelined writes only waited for TXE.
+    emu_spi_ticks = 1;
+    tft_init();
+
+    printf("%-26s %9s %9s %6s %7s %7s %7s\n", "phase", "uncached", "bytes", "saved", "windows", "CASET", "RASET");
+    for (uint8_t p = 0; p < sizeof(_phases) / sizeof(_phases[0]); p++)
+    {
+        _fill_rect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, BLACK);
+        _set_colors(WHITE, BLACK);
+        emu_flush();
+        emu_reset_stats();
+
+        _phases[p].run();
+        emu_flush();  // Also drains the DMA queue
+
+        // Without the cache, every window sends CASET and RASET, 5 bytes each
+        uint32_t uncached = emu_stats.bytes + 5 * (2 * emu_stats.windows - emu_stats.caset - emu_stats.raset);
+        printf("%-26s %9u %9u %5.1f%% %7u %7u %7u\n", _phases[p].name, uncached, emu_stats.bytes,
+               100.0 * (uncached - emu_stats.bytes) / uncached, emu_stats.windows, emu_stats.caset, emu_stats.raset);
+
+        CHECK(emu_stats.caset <= emu_stats.windows && emu_stats.raset <= emu_stats.windows);
+        CHECK(emu_stats.violations == 0);
+        CHECK(check_mismatches(_ref, _phases[p].name) == 0);
+    }
+
+    return check_result();
+}
+
+int main(void)
+{
+    return emu_run(_test);
+}
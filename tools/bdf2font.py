@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Convert a BDF bitmap font to a proportional font header for st7735.c.
+
+Usage:
+    python3 tools/bdf2font.py input.bdf name [-f FIRST] [-l LAST] [-o OUTPUT]
+                              [-d DOWNSAMPLE] [-b BPP]
+
+The header defines `name_bitmap`, `name_glyphs` and the `font_t name`, use it
+with `tft_set_font(&name)`. Glyphs are cropped to their set pixels and packed
+row-major, MSB first, each glyph starting on a byte.
+
+Anti-aliased fonts are made from a larger BDF font: `-d 4 -b 4` shrinks a
+32 pixel font to 8 pixels, each pixel storing its coverage in 4 bits.
+"""
+
+import argparse
+import sys
+
+
+def parse_bdf(path):
+    """Return (ascent, descent, {code: glyph}) of a BDF font."""
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    glyph = None
+    rows = None
+
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            words = line.split()
+            if not words:
+                continue
+            key = words[0]
+
+            if rows is not None:
+                if key == "ENDCHAR":
+                    glyph["rows"] = rows
+                    if glyph["code"] >= 0:
+                        glyphs[glyph["code"]] = glyph
+                    glyph = rows = None
+                else:
+                    rows.append(int(words[0], 16))
+                continue
+
+            if key == "FONTBOUNDINGBOX":
+                bbox = [int(v) for v in words[1:5]]
+            elif key == "FONT_ASCENT":
+                ascent = int(words[1])
+            elif key == "FONT_DESCENT":
+                descent = int(words[1])
+            elif key == "STARTCHAR":
+                glyph = {"code": -1, "dwidth": 0, "bbx": [0, 0, 0, 0]}
+            elif key == "ENCODING":
+                glyph["code"] = int(words[1])
+            elif key == "DWIDTH":
+                glyph["dwidth"] = int(words[1])
+            elif key == "BBX":
+                glyph["bbx"] = [int(v) for v in words[1:5]]
+            elif key == "BITMAP":
+                rows = []
+
+    if ascent is None or descent is None:
+        if bbox is None:
+            sys.exit("%s: no FONT_ASCENT/FONT_DESCENT or FONTBOUNDINGBOX" % path)
+        ascent = bbox[1] + bbox[3]
+        descent = -bbox[3]
+    return ascent, descent, glyphs
+
+
+def downsample(pixels, xoff, top, factor, bpp):
+    """Shrink 1-bit pixels by factor, return (levels, x_offset, top)."""
+    levels = (1 << bpp) - 1
+    x0 = xoff // factor  # Cells stay aligned to the origin
+    y0 = top // factor
+    w = (xoff + len(pixels[0]) + factor - 1) // factor - x0 if pixels else 0
+    h = (top + len(pixels) + factor - 1) // factor - y0
+    cover = [[0] * w for _ in range(h)]
+    for y, row in enumerate(pixels):
+        for x, p in enumerate(row):
+            if p:
+                cover[(top + y) // factor - y0][(xoff + x) // factor - x0] += 1
+    area = factor * factor
+    return [[(c * levels + area // 2) // area for c in row] for row in cover], x0, y0
+
+
+def crop(glyph, ascent, factor=1, bpp=1):
+    """Return (width, height, x_offset, y_offset, pixel rows) cropped to ink."""
+    w, h, xoff, yoff = glyph["bbx"]
+    row_bits = (w + 7) // 8 * 8
+    pixels = [[(row >> (row_bits - 1 - x)) & 1 for x in range(w)] for row in glyph["rows"][:h]]
+
+    top = ascent - (yoff + h)  # From the top of the line
+    if factor > 1 or bpp > 1:
+        pixels, xoff, top = downsample(pixels, xoff, top, factor, bpp)
+    while pixels and not any(pixels[0]):
+        pixels.pop(0)
+        top += 1
+    while pixels and not any(pixels[-1]):
+        pixels.pop()
+    if not pixels:
+        return 0, 0, 0, 0, []
+
+    inked = [[x for x, p in enumerate(row) if p] for row in pixels]
+    left = min(xs[0] for xs in inked if xs)
+    right = max(xs[-1] + 1 for xs in inked if xs)
+    pixels = [row[left:right] for row in pixels]
+    return right - left, len(pixels), xoff + left, top, pixels
+
+
+def pack(pixels, bpp=1):
+    """Pack pixel rows into bytes, MSB first, rows not padded."""
+    data = []
+    byte = bits = 0
+    for row in pixels:
+        for p in row:
+            byte = (byte << bpp) | p
+            bits += bpp
+            if bits == 8:
+                data.append(byte)
+                byte = bits = 0
+    if bits:
+        data.append(byte << (8 - bits))
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a BDF font to a st7735 font header.")
+    parser.add_argument("bdf", help="input BDF font")
+    parser.add_argument("name", help="C name of the font")
+    parser.add_argument("-f", "--first", type=int, default=32, help="first character (default 32)")
+    parser.add_argument("-l", "--last", type=int, default=126, help="last character (default 126)")
+    parser.add_argument("-o", "--output", help="output header (default NAME.h)")
+    parser.add_argument("-d", "--downsample", type=int, default=1, help="shrink the font by this factor (default 1)")
+    parser.add_argument("-b", "--bpp", type=int, default=1, choices=(1, 2, 4), help="bits per pixel (default 1)")
+    args = parser.parse_args()
+
+    if not 0 <= args.first <= args.last <= 255:
+        sys.exit("characters must be 0 <= first <= last <= 255")
+    if args.downsample < 1:
+        sys.exit("downsample factor must be at least 1")
+
+    ascent, descent, glyphs = parse_bdf(args.bdf)
+    factor = args.downsample
+    height = (ascent + descent + factor - 1) // factor
+    bitmap = []
+    table = []
+    for code in range(args.first, args.last + 1):
+        glyph = glyphs.get(code)
+        if glyph is None:
+            table.append((len(bitmap), 0, 0, 0, 0, 0, code))
+            continue
+        w, h, xoff, yoff, pixels = crop(glyph, ascent, factor, args.bpp)
+        advance = (glyph["dwidth"] + factor // 2) // factor
+        for value, name in ((w, "width"), (h, "height"), (advance, "advance")):
+            if not 0 <= value <= 255:
+                sys.exit("character %d: %s %d out of range" % (code, name, value))
+        for value, name in ((xoff, "x offset"), (yoff, "y offset")):
+            if not -128 <= value <= 127:
+                sys.exit("character %d: %s %d out of range" % (code, name, value))
+        table.append((len(bitmap), w, h, advance, xoff, yoff, code))
+        bitmap += pack(pixels, args.bpp)
+
+    if len(bitmap) > 0xFFFF:
+        sys.exit("bitmap of %d bytes is too large" % len(bitmap))
+
+    name = args.name
+    guard = name.upper() + "_H"
+    out = []
+    out.append("// Generated by tools/bdf2font.py from %s" % args.bdf.replace("\\", "/").split("/")[-1])
+    out.append("// Characters %d to %d, line height %d, %d bpp, %d bytes." %
+               (args.first, args.last, height, args.bpp, len(bitmap) + len(table) * 8))
+    out.append("")
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append('#include "st7735.h"')
+    out.append("")
+    out.append("static const uint8_t %s_bitmap[] = {" % name)
+    for i in range(0, len(bitmap), 12):
+        out.append("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 12]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const glyph_t %s_glyphs[] = {" % name)
+    for offset, w, h, adv, xoff, yoff, code in table:
+        label = chr(code) if 32 < code < 127 and code != 92 else "0x%02X" % code  # No line splice
+        out.append("    {%5d, %3d, %3d, %3d, %4d, %4d},  // %s" % (offset, w, h, adv, xoff, yoff, label))
+    out.append("};")
+    out.append("")
+    out.append("static const font_t %s = {%s_bitmap, %s_glyphs, %d, %d, %d, %d};" %
+               (name, name, name, args.first, args.last, height, args.bpp))
+    out.append("")
+    out.append("#endif  // %s" % guard)
+
+    with open(args.output or name + ".h", "w", newline="\n") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()